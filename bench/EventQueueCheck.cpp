@@ -0,0 +1,89 @@
+// Opt-in check that steady-state turns queue actions without touching
+// the heap. Starts a game on a dummy SDL video driver, lets the player
+// wait through a few warm-up turns so the event queue reaches its
+// working size, then waits through more and fails if
+// EventQueue::GetAllocationCount changed.
+//
+// Build with -DMYGAME_BUILD_BENCHMARKS=ON and run event_queue_check from
+// the build directory, where the game's data files are copied.
+
+#include "Command.hpp"
+#include "ConfigManager.hpp"
+#include "Configuration.hpp"
+#include "Engine.hpp"
+#include "EventQueue.hpp"
+#include "LocaleManager.hpp"
+#include "TurnManager.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+	using namespace tutorial;
+
+	constexpr int kWarmupTurns = 20;
+	constexpr int kCheckedTurns = 60;
+
+	// Wait out up to turns turns, returning how many were played
+	// before the game ended
+	int WaitTurns(Engine& engine, TurnManager& turnManager, int turns)
+	{
+		for (int turn = 0; turn < turns; ++turn) {
+			if (engine.IsGameOver()) {
+				return turn;
+			}
+			turnManager.ProcessCommand(
+			    std::make_unique<WaitCommand>(), engine);
+		}
+		return turns;
+	}
+} // namespace
+
+int main()
+{
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
+	ConfigManager::Instance().LoadAll();
+	LocaleManager::Instance().LoadLocale("en_US");
+
+	static const Configuration config {
+		"event_queue_check", // title
+		100,                 // width
+		50,                  // height
+		60,                  // fps
+		"font.bdf"           // fontPath
+	};
+	Engine engine { config };
+	TurnManager turnManager;
+	engine.NewGame();
+
+	WaitTurns(engine, turnManager, kWarmupTurns);
+
+	const auto& queue = engine.GetEventQueue();
+	std::size_t before = queue.GetAllocationCount();
+	int played = WaitTurns(engine, turnManager, kCheckedTurns);
+	std::size_t after = queue.GetAllocationCount();
+
+	std::cout << "turns checked: " << played
+	          << ", queue capacity: " << queue.GetCapacity()
+	          << ", allocations: " << before << " -> " << after
+	          << "\n";
+
+	if (played == 0) {
+		std::cerr << "FAIL: the game ended during warm-up\n";
+		return EXIT_FAILURE;
+	}
+
+	if (after != before) {
+		std::cerr << "FAIL: the event queue allocated after warm-up\n";
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "OK\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,421 @@
+// Opt-in FOV check and benchmark. First compares ComputeShadowcastFov,
+// including its windowed form, against a plain recursive transcription
+// of symmetric shadowcasting on a generated level and a random rubble
+// field, and checks that sight between floor tiles is mutual. Then
+// times Map::ComputeFov with each FovAlgorithm at radius 8, 20 and 60
+// and reports how many tiles each lights and how many only one of them
+// lights. Exits non-zero if any golden comparison fails.
+//
+// Build with -DMYGAME_BUILD_BENCHMARKS=ON and run fov_bench.
+
+#include "BasicDungeonGenerator.hpp"
+#include "BitGrid.hpp"
+#include "Fov.hpp"
+#include "Map.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	using namespace tutorial;
+
+	constexpr std::uint64_t kSeed = 0x5EED;
+	constexpr int kGoldenOrigins = 200;
+	constexpr int kGoldenRadii[] = { 0, 8, 20, 60 };
+	constexpr int kMutualTargets = 20;
+	constexpr int kBenchSize = 200;
+	constexpr int kBenchOrigins = 500;
+	constexpr int kBenchRadii[] = { 8, 20, 60 };
+
+	std::unique_ptr<Map> GenerateMap(int width, int height)
+	{
+		auto map = std::make_unique<Map>(width, height);
+
+		// Keep trail and room density near the 80x45 default
+		auto config =
+		    BasicDungeonGenerator::GetDefaultConfig(width, height);
+		int scale = std::max(1, (width * height) / (80 * 45));
+		config.numTrails *= scale;
+		config.minRooms *= scale;
+		config.maxRooms *= scale;
+
+		BasicDungeonGenerator generator(config);
+		map->Generate(generator);
+		return map;
+	}
+
+	// Open field with roughly one tile in four blocked, which puts far
+	// more wall corners in view than any generated level does
+	BitGrid MakeRubble(int width, int height, Rng& rng)
+	{
+		BitGrid transparent(width * height, true);
+		for (int index = 0; index < width * height; ++index) {
+			if (rng.GetInt(0, 3) == 0) {
+				transparent.Set(index, false);
+			}
+		}
+		return transparent;
+	}
+
+	struct Fraction {
+		std::int64_t num;
+		std::int64_t den;
+	};
+
+	std::int64_t FloorDiv(std::int64_t a, std::int64_t b)
+	{
+		std::int64_t q = a / b;
+		return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+	}
+
+	// floor(depth * slope + 1/2)
+	int RoundTiesUp(int depth, Fraction slope)
+	{
+		return static_cast<int>(FloorDiv(
+		    2 * depth * slope.num + slope.den, 2 * slope.den));
+	}
+
+	// ceil(depth * slope - 1/2)
+	int RoundTiesDown(int depth, Fraction slope)
+	{
+		return static_cast<int>(-FloorDiv(
+		    slope.den - 2 * depth * slope.num, 2 * slope.den));
+	}
+
+	// Symmetric shadowcasting as published: recursive, unlimited range,
+	// one quadrant at a time. The radius is applied afterwards.
+	class ReferenceFov
+	{
+	public:
+		ReferenceFov(const BitGrid& transparent, int width, int height,
+		             pos_t origin, BitGrid& visible)
+		    : transparent_(transparent),
+		      visible_(visible),
+		      width_(width),
+		      height_(height),
+		      origin_(origin)
+		{
+		}
+
+		void Compute(int radius)
+		{
+			visible_.Set(origin_.y * width_ + origin_.x, true);
+			for (quadrant_ = 0; quadrant_ < 4; ++quadrant_) {
+				Scan(1, { -1, 1 }, { 1, 1 });
+			}
+
+			if (radius <= 0) {
+				return;
+			}
+
+			for (int y = 0; y < height_; ++y) {
+				for (int x = 0; x < width_; ++x) {
+					int dx = x - origin_.x;
+					int dy = y - origin_.y;
+					if (dx * dx + dy * dy
+					    > radius * radius) {
+						visible_.Set(y * width_ + x,
+						             false);
+					}
+				}
+			}
+		}
+
+	private:
+		pos_t Transform(int depth, int col) const
+		{
+			switch (quadrant_) {
+				case 0:
+					return { origin_.x + col,
+						 origin_.y - depth };
+				case 1:
+					return { origin_.x + depth,
+						 origin_.y + col };
+				case 2:
+					return { origin_.x + col,
+						 origin_.y + depth };
+				default:
+					return { origin_.x - depth,
+						 origin_.y + col };
+			}
+		}
+
+		bool OnMap(pos_t pos) const
+		{
+			return pos.x >= 0 && pos.y >= 0 && pos.x < width_
+			       && pos.y < height_;
+		}
+
+		bool IsWall(pos_t pos) const
+		{
+			return !OnMap(pos)
+			       || !transparent_.Get(pos.y * width_ + pos.x);
+		}
+
+		void Scan(int depth, Fraction start, Fraction end)
+		{
+			if (depth > std::max(width_, height_)) {
+				return;
+			}
+
+			bool hasPrev = false;
+			bool prevWall = false;
+			for (int col = RoundTiesUp(depth, start);
+			     col <= RoundTiesDown(depth, end); ++col) {
+				pos_t pos = Transform(depth, col);
+				bool wall = IsWall(pos);
+
+				bool symmetric =
+				    col * start.den >= depth * start.num
+				    && col * end.den <= depth * end.num;
+				if ((wall || symmetric) && OnMap(pos)) {
+					visible_.Set(pos.y * width_ + pos.x,
+					             true);
+				}
+
+				Fraction slope { 2 * col - 1, 2 * depth };
+				if (hasPrev && prevWall && !wall) {
+					start = slope;
+				}
+				if (hasPrev && !prevWall && wall) {
+					Scan(depth + 1, start, slope);
+				}
+
+				hasPrev = true;
+				prevWall = wall;
+			}
+
+			if (hasPrev && !prevWall) {
+				Scan(depth + 1, start, end);
+			}
+		}
+
+		const BitGrid& transparent_;
+		BitGrid& visible_;
+		int width_;
+		int height_;
+		pos_t origin_;
+		int quadrant_ = 0;
+	};
+
+	pos_t RandomOpen(const BitGrid& transparent, int width, int height,
+	                 Rng& rng)
+	{
+		pos_t pos;
+		do {
+			pos = pos_t { rng.GetInt(0, width - 1),
+				      rng.GetInt(0, height - 1) };
+		} while (!transparent.Get(pos.y * width + pos.x));
+		return pos;
+	}
+
+	// Golden comparison plus mutual sight; returns the failure count
+	int CheckGolden(const char* name, const BitGrid& transparent,
+	                int width, int height, Rng& rng)
+	{
+		int failures = 0;
+		int size = width * height;
+		BitGrid expected(size);
+		BitGrid actual(size);
+
+		for (int i = 0; i < kGoldenOrigins; ++i) {
+			pos_t origin =
+			    RandomOpen(transparent, width, height, rng);
+
+			for (int radius : kGoldenRadii) {
+				expected.Fill(false);
+				ReferenceFov(transparent, width, height, origin,
+				             expected)
+				    .Compute(radius);
+
+				actual.Fill(false);
+				ComputeShadowcastFov(transparent, width, height,
+				                     origin, radius, actual);
+
+				// The windowed form must agree inside its
+				// window, here the radius box
+				int reach = radius;
+				if (radius <= 0) {
+					reach = std::max(width, height);
+				}
+				pos_t windowOrigin { origin.x - reach,
+					             origin.y - reach };
+				pos_t windowSize { 2 * reach + 1,
+					           2 * reach + 1 };
+				BitGrid window(windowSize.x * windowSize.y);
+				ComputeShadowcastFov(transparent, width, height,
+				                     origin, radius, window,
+				                     windowOrigin, windowSize);
+
+				bool same = true;
+				for (int index = 0; index < size; ++index) {
+					bool lit = expected.Get(index);
+					if (actual.Get(index) != lit) {
+						same = false;
+					}
+
+					int wx = index % width - windowOrigin.x;
+					int wy = index / width - windowOrigin.y;
+					if (wx < 0 || wy < 0
+					    || wx >= windowSize.x
+					    || wy >= windowSize.y) {
+						continue;
+					}
+
+					int local = wy * windowSize.x + wx;
+					if (window.Get(local) != lit) {
+						same = false;
+					}
+				}
+
+				if (!same) {
+					++failures;
+				}
+			}
+
+			// Every floor tile seen from origin must see it back
+			int targets = 0;
+			ComputeShadowcastFov(transparent, width, height, origin,
+			                     0, actual);
+			actual.ForEachSet([&](int index) {
+				if (targets == kMutualTargets
+				    || !transparent.Get(index)) {
+					return;
+				}
+				++targets;
+
+				pos_t target { index % width, index / width };
+				expected.Fill(false);
+				ComputeShadowcastFov(transparent, width, height,
+				                     target, 0, expected);
+				int back = origin.y * width + origin.x;
+				if (!expected.Get(back)) {
+					++failures;
+				}
+			});
+		}
+
+		std::cout << name << ": " << failures << " golden failures\n";
+		return failures;
+	}
+
+	struct FovTotals {
+		double micros = 0.0;
+		std::int64_t lit = 0;
+	};
+
+	FovTotals TimeFov(Map& map, const std::vector<pos_t>& origins,
+	                  int radius, FovAlgorithm algorithm)
+	{
+		FovTotals totals;
+		auto begin = std::chrono::steady_clock::now();
+		for (pos_t origin : origins) {
+			map.ComputeFov(origin, radius, algorithm);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - begin;
+		totals.micros =
+		    std::chrono::duration<double, std::micro>(elapsed).count();
+
+		// Lit counts are gathered outside the timed loop
+		for (pos_t origin : origins) {
+			map.ComputeFov(origin, radius, algorithm);
+			map.GetFovPlane().ForEachSet(
+			    [&](int) { ++totals.lit; });
+		}
+		return totals;
+	}
+
+	// Tiles lit by exactly one of the two algorithms
+	std::int64_t CountDisagreements(Map& map,
+	                                const std::vector<pos_t>& origins,
+	                                int radius)
+	{
+		int size = map.GetWidth() * map.GetHeight();
+		std::int64_t count = 0;
+		BitGrid shadowcast(size);
+
+		for (pos_t origin : origins) {
+			map.ComputeFov(origin, radius,
+			               FovAlgorithm::Shadowcast);
+			shadowcast.Fill(false);
+			shadowcast.OrWith(map.GetFovPlane());
+
+			map.ComputeFov(origin, radius,
+			               FovAlgorithm::Restrictive);
+			const BitGrid& restrictive = map.GetFovPlane();
+			for (int index = 0; index < size; ++index) {
+				if (shadowcast.Get(index)
+				    != restrictive.Get(index)) {
+					++count;
+				}
+			}
+		}
+		return count;
+	}
+
+	void RunBench(Rng& rng)
+	{
+		auto map = GenerateMap(kBenchSize, kBenchSize);
+
+		std::vector<pos_t> origins;
+		for (int i = 0; i < kBenchOrigins; ++i) {
+			origins.push_back(RandomOpen(map->GetTransparentPlane(),
+			                             kBenchSize, kBenchSize,
+			                             rng));
+		}
+
+		std::cout << std::left << std::setw(8) << "radius"
+		          << std::right << std::setw(14) << "shadow us"
+		          << std::setw(14) << "restrict us" << std::setw(14)
+		          << "shadow lit" << std::setw(14) << "restrict lit"
+		          << std::setw(14) << "differ" << "\n";
+
+		double count = static_cast<double>(origins.size());
+		for (int radius : kBenchRadii) {
+			FovTotals shadowcast = TimeFov(
+			    *map, origins, radius, FovAlgorithm::Shadowcast);
+			FovTotals restrictive = TimeFov(
+			    *map, origins, radius, FovAlgorithm::Restrictive);
+			std::int64_t differ =
+			    CountDisagreements(*map, origins, radius);
+
+			std::cout << std::left << std::setw(8) << radius
+			          << std::right << std::fixed
+			          << std::setprecision(1) << std::setw(14)
+			          << shadowcast.micros / count << std::setw(14)
+			          << restrictive.micros / count << std::setw(14)
+			          << shadowcast.lit / count << std::setw(14)
+			          << restrictive.lit / count << std::setw(14)
+			          << differ / count << "\n";
+		}
+	}
+} // namespace
+
+int main()
+{
+	using namespace tutorial;
+
+	RandomService::Instance().Seed(kSeed);
+	Rng rng(kSeed);
+
+	int failures = 0;
+
+	auto level = GenerateMap(80, 45);
+	failures += CheckGolden("80x45 level", level->GetTransparentPlane(),
+	                        80, 45, rng);
+
+	BitGrid rubble = MakeRubble(64, 64, rng);
+	failures += CheckGolden("64x64 rubble", rubble, 64, 64, rng);
+
+	RunBench(rng);
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,204 @@
+// Opt-in consistency check for the HPA* NavGraph. On generated maps it
+// verifies that PathAlgorithm::Hierarchical finds a route exactly when
+// A* does, that every route is walkable without cutting corners and
+// never beats the optimal cost, and that a graph patched through
+// OnTileChanged answers like one rebuilt from scratch. Exits non-zero
+// if any query disagrees.
+//
+// Build with -DMYGAME_BUILD_BENCHMARKS=ON and run navgraph_check.
+
+#include "BasicDungeonGenerator.hpp"
+#include "Map.hpp"
+#include "NavGraph.hpp"
+#include "PathFinding.hpp"
+#include "Random.hpp"
+#include "Tile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	using namespace tutorial;
+
+	constexpr std::uint64_t kSeed = 0x5EED;
+	constexpr int kQueries = 500;
+	constexpr int kToggleRounds = 20;
+	constexpr int kTogglesPerRound = 25;
+	constexpr int kRepairQueries = 100;
+
+	struct MapCase {
+		const char* name;
+		int width;
+		int height;
+	};
+
+	constexpr MapCase kMaps[] = { { "80x45", 80, 45 },
+		                      { "400x400", 400, 400 } };
+
+	std::unique_ptr<Map> GenerateMap(int width, int height)
+	{
+		auto map = std::make_unique<Map>(width, height);
+
+		// Keep trail and room density near the 80x45 default
+		auto config =
+		    BasicDungeonGenerator::GetDefaultConfig(width, height);
+		int scale = std::max(1, (width * height) / (80 * 45));
+		config.numTrails *= scale;
+		config.minRooms *= scale;
+		config.maxRooms *= scale;
+
+		BasicDungeonGenerator generator(config);
+		map->Generate(generator);
+		return map;
+	}
+
+	pos_t RandomFloor(const Map& map, Rng& rng)
+	{
+		pos_t pos;
+		do {
+			pos = pos_t { rng.GetInt(0, map.GetWidth() - 1),
+				      rng.GetInt(0, map.GetHeight() - 1) };
+		} while (map.IsWall(pos));
+		return pos;
+	}
+
+	// Octile cost of path, or -1 if some step is not a legal move
+	int RouteCost(const Map& map, const std::vector<pos_t>& path)
+	{
+		int cost = 0;
+		for (std::size_t i = 1; i < path.size(); ++i) {
+			pos_t from = path[i - 1];
+			pos_t dir = path[i] - from;
+			if (std::abs(dir.x) > 1 || std::abs(dir.y) > 1
+			    || (dir.x == 0 && dir.y == 0)
+			    || map.IsWall(path[i])) {
+				return -1;
+			}
+
+			if (dir.x != 0 && dir.y != 0) {
+				if (map.IsWall({ from.x + dir.x, from.y })
+				    || map.IsWall({ from.x, from.y + dir.y })) {
+					return -1;
+				}
+				cost += 14;
+			} else {
+				cost += 10;
+			}
+		}
+		return cost;
+	}
+
+	// Hierarchical against A* on the same queries
+	int CheckRoutes(const Map& map, Rng& rng)
+	{
+		int failures = 0;
+		std::vector<pos_t> optimal;
+		std::vector<pos_t> route;
+
+		for (int i = 0; i < kQueries; ++i) {
+			pos_t start = RandomFloor(map, rng);
+			pos_t end = RandomFloor(map, rng);
+
+			bool foundOptimal = FindPath(map, start, end, optimal,
+			                             PathAlgorithm::AStar);
+			bool found = FindPath(map, start, end, route,
+			                      PathAlgorithm::Hierarchical);
+
+			if (found != foundOptimal) {
+				++failures;
+				continue;
+			}
+
+			if (!found) {
+				continue;
+			}
+
+			int cost = RouteCost(map, route);
+			if (route.front() != start || route.back() != end
+			    || cost < 0 || cost < RouteCost(map, optimal)) {
+				++failures;
+			}
+		}
+
+		return failures;
+	}
+
+	// Patched graph against a fresh build after random wall toggles
+	int CheckRepair(Map& map, Rng& rng)
+	{
+		int failures = 0;
+		auto& context = PathfindingContext::ThreadLocal();
+		std::vector<pos_t> patchedWaypoints;
+		std::vector<pos_t> rebuiltWaypoints;
+
+		for (int round = 0; round < kToggleRounds; ++round) {
+			for (int i = 0; i < kTogglesPerRound; ++i) {
+				int x = rng.GetInt(1, map.GetWidth() - 2);
+				int y = rng.GetInt(1, map.GetHeight() - 2);
+				pos_t pos { x, y };
+				map.SetTileType(pos, map.IsWall(pos)
+				                         ? TileType::FLOOR
+				                         : TileType::WALL);
+			}
+
+			const auto& patched = map.GetNavGraph();
+			NavGraph rebuilt;
+			rebuilt.Build(map.GetWalkablePlane(), map.GetWidth(),
+			              map.GetHeight());
+
+			if (patched.GetNodeCount() != rebuilt.GetNodeCount()) {
+				++failures;
+				continue;
+			}
+
+			for (int i = 0; i < kRepairQueries; ++i) {
+				pos_t start = RandomFloor(map, rng);
+				pos_t end = RandomFloor(map, rng);
+
+				bool patchedFound = patched.FindAbstractPath(
+				    map.GetWalkablePlane(), start, end, context,
+				    patchedWaypoints, nullptr);
+				bool rebuiltFound = rebuilt.FindAbstractPath(
+				    map.GetWalkablePlane(), start, end, context,
+				    rebuiltWaypoints, nullptr);
+
+				if (patchedFound != rebuiltFound
+				    || patchedWaypoints != rebuiltWaypoints) {
+					++failures;
+				}
+			}
+		}
+
+		return failures;
+	}
+} // namespace
+
+int main()
+{
+	using namespace tutorial;
+
+	RandomService::Instance().Seed(kSeed);
+
+	int failures = 0;
+	for (const auto& mapCase : kMaps) {
+		auto map = GenerateMap(mapCase.width, mapCase.height);
+		Rng rng(kSeed);
+
+		int routeFailures = CheckRoutes(*map, rng);
+		int repairFailures = CheckRepair(*map, rng);
+
+		std::cout << mapCase.name << ": "
+		          << map->GetNavGraph().GetNodeCount() << " nodes, "
+		          << routeFailures << "/" << kQueries
+		          << " route failures, " << repairFailures
+		          << " repair failures\n";
+		failures += routeFailures + repairFailures;
+	}
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,189 @@
+// Opt-in FindPath benchmark. Generates a normal 80x45 level and a
+// 1000x1000 one from a fixed seed, runs the same random queries through
+// every PathAlgorithm and reports nodes expanded, tiles touched and wall
+// time per query from PathfindingStats. A second pass walks each query
+// a few steps through a PathCache, replanning on every step the way a
+// monster following a noise does, and reports the cache hit rate.
+//
+// Build with -DMYGAME_BUILD_BENCHMARKS=ON and run pathfinding_bench.
+
+#include "BasicDungeonGenerator.hpp"
+#include "Map.hpp"
+#include "PathFinding.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using namespace tutorial;
+
+	constexpr std::uint64_t kSeed = 0x5EED;
+
+	struct MapCase {
+		const char* name;
+		int width;
+		int height;
+		int queries;
+	};
+
+	struct AlgorithmCase {
+		const char* name;
+		PathAlgorithm algorithm;
+	};
+
+	constexpr MapCase kMaps[] = { { "80x45", 80, 45, 2000 },
+		                      { "1000x1000", 1000, 1000, 100 } };
+
+	// Steps each cached query is walked, replanning every step
+	constexpr int kWalkSteps = 8;
+
+	constexpr AlgorithmCase kAlgorithms[] = {
+		{ "BestFirst", PathAlgorithm::BestFirst },
+		{ "AStar", PathAlgorithm::AStar },
+		{ "JumpPoint", PathAlgorithm::JumpPoint },
+		{ "Hierarchical", PathAlgorithm::Hierarchical }
+	};
+
+	std::unique_ptr<Map> GenerateMap(int width, int height)
+	{
+		auto map = std::make_unique<Map>(width, height);
+
+		// Keep trail and room density near the 80x45 default
+		auto config =
+		    BasicDungeonGenerator::GetDefaultConfig(width, height);
+		int scale = std::max(1, (width * height) / (80 * 45));
+		config.numTrails *= scale;
+		config.minRooms *= scale;
+		config.maxRooms *= scale;
+
+		BasicDungeonGenerator generator(config);
+		map->Generate(generator);
+		return map;
+	}
+
+	pos_t RandomFloor(const Map& map, Rng& rng)
+	{
+		pos_t pos;
+		do {
+			pos = pos_t { rng.GetInt(0, map.GetWidth() - 1),
+				      rng.GetInt(0, map.GetHeight() - 1) };
+		} while (map.IsWall(pos));
+		return pos;
+	}
+
+	void RunMap(const MapCase& mapCase)
+	{
+		auto map = GenerateMap(mapCase.width, mapCase.height);
+
+		Rng rng(kSeed);
+		std::vector<std::pair<pos_t, pos_t>> queries;
+		for (int i = 0; i < mapCase.queries; ++i) {
+			pos_t start = RandomFloor(*map, rng);
+			queries.emplace_back(start, RandomFloor(*map, rng));
+		}
+
+		// Build the HPA* graph up front, as a game would have done
+		// on an earlier query
+		map->GetNavGraph();
+
+		std::vector<pos_t> path;
+		for (const auto& algorithmCase : kAlgorithms) {
+			std::int64_t expanded = 0;
+			std::int64_t touched = 0;
+			std::int64_t steps = 0;
+			int found = 0;
+
+			auto begin = std::chrono::steady_clock::now();
+			for (const auto& [start, end] : queries) {
+				PathfindingStats stats;
+				if (FindPath(*map, start, end, path,
+				             algorithmCase.algorithm, &stats)) {
+					++found;
+					steps += static_cast<std::int64_t>(
+					    path.size() - 1);
+				}
+				expanded += stats.nodesExpanded;
+				touched += stats.nodesTouched;
+			}
+			auto elapsed = std::chrono::steady_clock::now() - begin;
+
+			double count = static_cast<double>(queries.size());
+			double micros =
+			    std::chrono::duration<double, std::micro>(elapsed)
+			        .count();
+			std::cout << std::left << std::setw(11) << mapCase.name
+			          << std::setw(14) << algorithmCase.name
+			          << std::right << std::setw(7) << found
+			          << std::setw(12) << std::fixed
+			          << std::setprecision(1) << steps / count
+			          << std::setw(12) << expanded / count
+			          << std::setw(12) << touched / count
+			          << std::setw(12) << micros / count << "\n";
+		}
+
+		for (const auto& algorithmCase : kAlgorithms) {
+			PathCache cache;
+			std::int64_t hits = 0;
+			std::int64_t misses = 0;
+
+			auto begin = std::chrono::steady_clock::now();
+			for (const auto& [start, end] : queries) {
+				pos_t pos = start;
+				for (int step = 0; step < kWalkSteps; ++step) {
+					PathfindingStats stats;
+					bool found = cache.FindPath(
+					    *map, pos, end, path,
+					    algorithmCase.algorithm, &stats);
+					hits += stats.cacheHits;
+					misses += stats.cacheMisses;
+					if (!found || path.size() < 2) {
+						break;
+					}
+					pos = path[1];
+				}
+			}
+			auto elapsed = std::chrono::steady_clock::now() - begin;
+
+			double lookups = static_cast<double>(hits + misses);
+			double micros =
+			    std::chrono::duration<double, std::micro>(elapsed)
+			        .count();
+			std::cout << std::left << std::setw(11) << mapCase.name
+			          << std::setw(14) << algorithmCase.name
+			          << std::right << std::setw(7) << "cached"
+			          << std::setw(12) << hits << std::setw(12)
+			          << misses << std::setw(12) << std::fixed
+			          << std::setprecision(1)
+			          << 100.0 * hits / lookups << std::setw(12)
+			          << micros / lookups << "\n";
+		}
+	}
+} // namespace
+
+int main()
+{
+	using namespace tutorial;
+
+	RandomService::Instance().Seed(kSeed);
+
+	std::cout << std::left << std::setw(11) << "map" << std::setw(14)
+	          << "algorithm" << std::right << std::setw(7) << "found"
+	          << std::setw(12) << "steps" << std::setw(12) << "expanded"
+	          << std::setw(12) << "touched" << std::setw(12) << "us/query"
+	          << "\n";
+	std::cout << "cached rows: hits, misses, hit %, us/query\n";
+
+	for (const auto& mapCase : kMaps) {
+		RunMap(mapCase);
+	}
+
+	return 0;
+}
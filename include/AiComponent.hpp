@@ -1,7 +1,10 @@
 #ifndef AI_COMPONENT_HPP
 #define AI_COMPONENT_HPP
 
+#include "Position.hpp"
+
 #include <memory>
+#include <optional>
 
 namespace tutorial
 {
@@ -9,15 +12,63 @@ namespace tutorial
 	class Entity;
 
 	// After 20 turns, monsters cannot smell the scent anymore
-	// This constant is also used to initialize Map::currentScentValue_
+	// This constant is also used to initialize the ScentField clock
 	static constexpr unsigned int SCENT_THRESHOLD = 20;
 
+	// What an AI means to do with its turn. Worked out from a read-only
+	// look at the world, so the plans for a whole turn can be made at
+	// once and carried out afterwards.
+	struct AiIntent {
+		enum class Kind {
+			Perform, // Nothing planned ahead; Perform at commit
+			Idle,
+			Wait,
+			Move,
+			Attack,
+			Sleep
+		};
+
+		Kind kind = Kind::Perform;
+		pos_t step { 0, 0 }; // Move or Attack direction
+		bool noticedPlayer = false;
+	};
+
 	class AiComponent
 	{
 	public:
 		virtual ~AiComponent() = default;
 
 		virtual void Perform(Engine& engine, Entity& entity) = 0;
+
+		// Plan the turn without changing anything, this AI included.
+		// Runs on worker threads, while nothing else touches the
+		// world. AIs that cannot plan ahead leave it to Perform.
+		virtual AiIntent Decide(const Engine& /*engine*/,
+		                        const Entity& /*entity*/) const
+		{
+			return AiIntent {};
+		}
+
+		// Carry out a plan from Decide on the main thread, against
+		// the world as it stands after earlier commits
+		virtual void Commit(Engine& engine, Entity& entity,
+		                    const AiIntent& /*intent*/)
+		{
+			Perform(engine, entity);
+		}
+
+		// Whether a dormant actor with this AI should wake up this
+		// turn. By default any AI that is looked at stays awake.
+		virtual bool NoticesPlayer(const Engine& /*engine*/,
+		                           const Entity& /*entity*/) const
+		{
+			return true;
+		}
+
+		// A noise from origin reached the actor
+		virtual void Hear(pos_t /*origin*/)
+		{
+		}
 	};
 
 	class BaseAi : public AiComponent
@@ -26,10 +77,23 @@ namespace tutorial
 		virtual void Perform(Engine& engine, Entity& entity) override;
 	};
 
+	// Chases the player while it can see or smell them, walks toward
+	// the last noise it heard otherwise, and goes dormant once it has
+	// nothing left to follow
 	class HostileAi : public BaseAi
 	{
 	public:
 		void Perform(Engine& engine, Entity& entity) override;
+		AiIntent Decide(const Engine& engine,
+		                const Entity& entity) const override;
+		void Commit(Engine& engine, Entity& entity,
+		            const AiIntent& intent) override;
+		bool NoticesPlayer(const Engine& engine,
+		                   const Entity& entity) const override;
+		void Hear(pos_t origin) override;
+
+	private:
+		std::optional<pos_t> noise_;
 	};
 
 	class ConfusedMonsterAi : public AiComponent
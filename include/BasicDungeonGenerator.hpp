@@ -27,7 +27,7 @@ namespace tutorial
 	};
 
 	// DCSS-style basic dungeon generator
-	// Generates: trails -> connections -> rooms -> doors
+	// Generates: trails -> rooms -> connections -> doors
 	class BasicDungeonGenerator : public Map::Generator
 	{
 	public:
@@ -46,10 +46,7 @@ namespace tutorial
 		// Phase 1: Generate winding trails
 		void GenerateTrails(Map& map);
 
-		// Phase 2: Connect all trail endpoints with pathfinding
-		void ConnectTrails(Map& map);
-
-		// Phase 3: Place rooms over the structure
+		// Phase 2: Place rooms over the structure
 		void PlaceRooms(Map& map);
 
 		BasicDungeonConfig config_;
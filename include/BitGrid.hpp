@@ -0,0 +1,123 @@
+#ifndef BIT_GRID_HPP
+#define BIT_GRID_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace tutorial
+{
+	// One bit per tile, packed 64 tiles to a word in row-major order.
+	// Accessors take a flat tile index and do no bounds checking; callers
+	// validate positions once at their boundary. Bits past the last tile
+	// are kept zero so whole-word operations never see stray tiles.
+	class BitGrid
+	{
+	public:
+		using Word = std::uint64_t;
+		static constexpr int kWordBits = 64;
+
+		BitGrid() = default;
+
+		explicit BitGrid(int size, bool value = false)
+		{
+			Assign(size, value);
+		}
+
+		void Assign(int size, bool value)
+		{
+			size_ = size;
+			words_.assign((size + kWordBits - 1) / kWordBits, 0);
+			Fill(value);
+		}
+
+		void Fill(bool value)
+		{
+			std::fill(words_.begin(), words_.end(),
+			          value ? ~Word { 0 } : Word { 0 });
+			MaskTail();
+		}
+
+		bool Get(int index) const
+		{
+			Word word = words_[index / kWordBits];
+			return (word >> (index % kWordBits)) & 1;
+		}
+
+		void Set(int index, bool value)
+		{
+			Word bit = Word { 1 } << (index % kWordBits);
+			Word& word = words_[index / kWordBits];
+			word = value ? (word | bit) : (word & ~bit);
+		}
+
+		// this |= other, 64 tiles at a time
+		void OrWith(const BitGrid& other)
+		{
+			for (std::size_t i = 0; i < words_.size(); ++i) {
+				words_[i] |= other.words_[i];
+			}
+		}
+
+		// Call fn(index) for every set bit in ascending order
+		template <typename Fn>
+		void ForEachSet(Fn&& fn) const
+		{
+			for (std::size_t i = 0; i < words_.size(); ++i) {
+				Word word = words_[i];
+				while (word) {
+					int bit = CountTrailingZeros(word);
+					fn(static_cast<int>(i) * kWordBits
+					   + bit);
+
+					word &= word - 1;
+				}
+			}
+		}
+
+		int GetSize() const
+		{
+			return size_;
+		}
+
+		const std::vector<Word>& GetWords() const
+		{
+			return words_;
+		}
+
+		std::vector<Word>& GetWords()
+		{
+			return words_;
+		}
+
+		static int CountTrailingZeros(Word word)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return static_cast<int>(index);
+#else
+			return __builtin_ctzll(word);
+#endif
+		}
+
+	private:
+		void MaskTail()
+		{
+			int tail = size_ % kWordBits;
+			if (tail != 0 && !words_.empty()) {
+				words_.back() &= (Word { 1 } << tail) - 1;
+			}
+		}
+
+		std::vector<Word> words_;
+		int size_ = 0;
+	};
+} // namespace tutorial
+
+#endif // BIT_GRID_HPP
@@ -1,6 +1,8 @@
 #ifndef COMMAND_HPP
 #define COMMAND_HPP
 
+#include "EntityHandle.hpp"
+
 #include <memory>
 #include <string>
 
@@ -256,13 +258,13 @@ namespace tutorial
 	class PickupItemCommand final : public ActionCommand
 	{
 	public:
-		PickupItemCommand(Entity* item) : item_(item)
+		PickupItemCommand(EntityHandle item) : item_(item)
 		{
 		}
 		void Execute(Engine& engine) override;
 
 	private:
-		Entity* item_;
+		EntityHandle item_;
 	};
 
 	class UseItemCommand final : public Command
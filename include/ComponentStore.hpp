@@ -0,0 +1,184 @@
+#ifndef COMPONENT_STORE_HPP
+#define COMPONENT_STORE_HPP
+
+#include "AiComponent.hpp"
+#include "Components.hpp"
+#include "Position.hpp"
+#include "SpellcasterComponent.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tutorial
+{
+	// Entity id within one EntityManager: the slot index its handle
+	// carries. Reused once the entity is removed.
+	using EntityId = std::uint32_t;
+
+	// Sparse set holding one component type. Values live in fixed-size
+	// pages that never move, so a pointer from Get stays valid until
+	// that id's value is extracted, however many other values come and
+	// go. A removed value leaves a hole that the next Insert reuses,
+	// which keeps the pages nearly full and a system's walk over them
+	// close to contiguous.
+	template <typename T>
+	class ComponentPool
+	{
+	public:
+		bool Has(EntityId id) const
+		{
+			return id < sparse_.size() && sparse_[id] != kAbsent;
+		}
+
+		T* Get(EntityId id)
+		{
+			return Has(id) ? &*At(sparse_[id]) : nullptr;
+		}
+
+		const T* Get(EntityId id) const
+		{
+			return Has(id) ? &*At(sparse_[id]) : nullptr;
+		}
+
+		// Add id's value, replacing any it already has in place
+		T& Insert(EntityId id, T value)
+		{
+			if (Has(id)) {
+				return *At(sparse_[id]) = std::move(value);
+			}
+
+			if (free_.empty()) {
+				AddPage();
+			}
+			std::uint32_t slot = free_.back();
+			free_.pop_back();
+
+			if (id >= sparse_.size()) {
+				sparse_.resize(id + 1, kAbsent);
+			}
+			sparse_[id] = slot;
+			owners_[slot] = id;
+			++count_;
+
+			return At(slot).emplace(std::move(value));
+		}
+
+		// Remove id's value and hand it back; id must be present
+		T Extract(EntityId id)
+		{
+			std::uint32_t slot = sparse_[id];
+			T value = std::move(*At(slot));
+
+			At(slot).reset();
+			owners_[slot] = kAbsent;
+			free_.push_back(slot);
+			sparse_[id] = kAbsent;
+			--count_;
+
+			return value;
+		}
+
+		void Clear()
+		{
+			pages_.clear();
+			owners_.clear();
+			sparse_.clear();
+			free_.clear();
+			count_ = 0;
+		}
+
+		std::size_t size() const
+		{
+			return count_;
+		}
+
+		// Call fn(id, value) for every value, in storage order
+		template <typename Fn>
+		void ForEach(Fn&& fn)
+		{
+			for (std::size_t slot = 0; slot < owners_.size();
+			     ++slot) {
+				if (owners_[slot] != kAbsent) {
+					fn(owners_[slot], *At(slot));
+				}
+			}
+		}
+
+		template <typename Fn>
+		void ForEach(Fn&& fn) const
+		{
+			for (std::size_t slot = 0; slot < owners_.size();
+			     ++slot) {
+				if (owners_[slot] != kAbsent) {
+					fn(owners_[slot], *At(slot));
+				}
+			}
+		}
+
+	private:
+		static constexpr std::uint32_t kAbsent = 0xFFFFFFFF;
+		static constexpr std::size_t kPageSize = 64;
+
+		using Page = std::array<std::optional<T>, kPageSize>;
+
+		std::optional<T>& At(std::size_t slot)
+		{
+			return (*pages_[slot / kPageSize])[slot % kPageSize];
+		}
+
+		const std::optional<T>& At(std::size_t slot) const
+		{
+			return (*pages_[slot / kPageSize])[slot % kPageSize];
+		}
+
+		void AddPage()
+		{
+			std::size_t first = owners_.size();
+			pages_.push_back(std::make_unique<Page>());
+			owners_.resize(first + kPageSize, kAbsent);
+
+			// Hand out the lowest slot first
+			for (std::size_t i = kPageSize; i > 0; --i) {
+				free_.push_back(
+				    static_cast<std::uint32_t>(first + i - 1));
+			}
+		}
+
+		std::vector<std::unique_ptr<Page>> pages_;
+		std::vector<EntityId> owners_;      // Slot -> id, or kAbsent
+		std::vector<std::uint32_t> sparse_; // Id -> slot
+		std::vector<std::uint32_t> free_;   // Empty slots, next last
+		std::size_t count_ = 0;
+	};
+
+	// Components of every entity an EntityManager owns, one pool per
+	// type. Entities fill it when spawned and take their components
+	// back when removed, so anything outside a manager (inventory
+	// items, a level still being planned) keeps working unchanged.
+	struct ComponentStore {
+		ComponentPool<pos_t> positions;
+		ComponentPool<DestructibleComponent> destructibles;
+		ComponentPool<AttackerComponent> attackers;
+		ComponentPool<IconRenderable> renderables;
+		ComponentPool<SpellcasterComponent> spellcasters;
+		// Null while an Npc's AI is swapped out
+		ComponentPool<std::unique_ptr<AiComponent>> ai;
+
+		void Clear()
+		{
+			positions.Clear();
+			destructibles.Clear();
+			attackers.Clear();
+			renderables.Clear();
+			spellcasters.Clear();
+			ai.Clear();
+		}
+	};
+} // namespace tutorial
+
+#endif // COMPONENT_STORE_HPP
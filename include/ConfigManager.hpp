@@ -1,6 +1,9 @@
 #ifndef CONFIG_MANAGER_HPP
 #define CONFIG_MANAGER_HPP
 
+#include "Fov.hpp"
+#include "ScentField.hpp"
+
 #include <libtcod/color.hpp>
 #include <nlohmann/json.hpp>
 
@@ -22,8 +25,10 @@ namespace tutorial
 
 		// === Game Config Accessors ===
 		int GetPlayerFOVRadius() const;
+		FovAlgorithm GetPlayerFOVAlgorithm() const;
 		int GetMaxInventorySize() const;
 		float GetDifficultyMultiplier() const;
+		ScentField::Config GetScentConfig() const;
 
 		// Debug flags
 		bool IsDebugShowAllMap() const;
@@ -89,6 +94,8 @@ namespace tutorial
 
 		nlohmann::json gameConfig_;
 		nlohmann::json uiConfig_;
+		// Parsed from player.fov_algorithm by LoadGameConfig
+		FovAlgorithm fovAlgorithm_ = FovAlgorithm::Restrictive;
 	};
 } // namespace tutorial
 
@@ -0,0 +1,68 @@
+#ifndef CONNECTIVITY_ANALYZER_HPP
+#define CONNECTIVITY_ANALYZER_HPP
+
+#include "BitGrid.hpp"
+#include "Position.hpp"
+
+#include <vector>
+
+namespace tutorial
+{
+	class Map;
+
+	// Connected components of the walkable plane, labelled with one
+	// union-find pass. Tiles join orthogonally only. Movement can
+	// currently squeeze diagonally between two walls, but those links
+	// are ignored on purpose: every component is then reachable
+	// without cutting corners, so the guarantee holds even if
+	// corner-cutting is disallowed later.
+	class ConnectivityAnalyzer
+	{
+	public:
+		// Wall tiles that, once carved, join two components
+		struct Cut {
+			int from; // Component ids
+			int to;
+			std::vector<pos_t> walls;
+		};
+
+		void Analyze(const BitGrid& walkable, int width, int height);
+
+		int GetComponentCount() const
+		{
+			return static_cast<int>(sizes_.size());
+		}
+
+		// Component id of pos, or -1 for walls
+		int GetComponent(pos_t pos) const;
+
+		int GetComponentSize(int component) const
+		{
+			return sizes_[component];
+		}
+
+		bool IsConnected() const
+		{
+			return sizes_.size() <= 1;
+		}
+
+		// Cheapest cuts that join every component into one: a
+		// spanning tree over the fewest walls between neighbouring
+		// components, found by growing all components through the
+		// walls at once. Never cuts the outer ring of the map. Empty
+		// when already connected.
+		std::vector<Cut> FindCuts() const;
+
+		// Analyze map, carve FindCuts into it, then analyze again so
+		// IsConnected reports the result. Returns the tiles carved.
+		int Connect(Map& map);
+
+	private:
+		std::vector<int> labels_; // Tile -> component, or -1
+		std::vector<int> sizes_;
+		int width_ = 0;
+		int height_ = 0;
+	};
+} // namespace tutorial
+
+#endif // CONNECTIVITY_ANALYZER_HPP
@@ -16,6 +16,11 @@ namespace tutorial
 		// Get singleton instance
 		static DynamicSpawnSystem& Instance();
 
+		// Standalone tables, for a level built away from the shared
+		// instance
+		DynamicSpawnSystem() = default;
+		~DynamicSpawnSystem() = default;
+
 		// Build spawn tables from a level configuration
 		void BuildSpawnTablesForLevel(const LevelConfig& level);
 
@@ -36,9 +41,6 @@ namespace tutorial
 		void Clear();
 
 	private:
-		DynamicSpawnSystem() = default;
-		~DynamicSpawnSystem() = default;
-
 		// Prevent copying
 		DynamicSpawnSystem(const DynamicSpawnSystem&) = delete;
 		DynamicSpawnSystem& operator=(const DynamicSpawnSystem&) =
@@ -4,20 +4,26 @@
 #include "Components.hpp"
 #include "ConfigManager.hpp"
 #include "Configuration.hpp"
+#include "EntityHandle.hpp"
 #include "EntityManager.hpp"
+#include "FlowField.hpp"
 #include "Event.hpp"
+#include "EventQueue.hpp"
 #include "InventoryMode.hpp"
 #include "LevelConfig.hpp"
+#include "LevelPrefetcher.hpp"
+#include "LineOfSight.hpp"
 #include "MessageLog.hpp"
+#include "PathFinding.hpp"
 #include "Position.hpp"
 #include "SpellcasterComponent.hpp"
 #include "TargetingCursor.hpp"
 #include "TemplateRegistry.hpp"
+#include "VisibilityService.hpp"
 
 #include <SDL3/SDL.h>
 #include <libtcod.h>
 
-#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
@@ -66,13 +72,11 @@ namespace tutorial
 
 	class Engine
 	{
-		using Event_ptr = std::unique_ptr<Event>;
-
 	public:
 		explicit Engine(const Configuration& config);
 		~Engine();
 
-		void AddEventFront(Event_ptr& event);
+		void AddEventFront(ActionRecord action);
 		void ComputeFOV();
 		std::unique_ptr<Command> GetInput();
 		void HandleDeathEvent(Entity& entity);
@@ -117,21 +121,29 @@ namespace tutorial
 		{
 			return inventoryMode_;
 		}
-		const std::vector<Entity*>& GetItemSelectionList() const
+		const std::vector<EntityHandle>& GetItemSelectionList() const
 		{
 			return itemSelectionList_;
 		}
 		void Quit();
-		std::unique_ptr<Entity> RemoveEntity(Entity* entity);
+		std::unique_ptr<Entity> RemoveEntity(EntityHandle handle);
 		Entity* SpawnEntity(std::unique_ptr<Entity> entity, pos_t pos);
+		void MoveEntity(Entity& entity, pos_t pos);
 
 		Entity* GetBlockingEntity(pos_t pos) const;
 		Entity* GetPlayer() const;
+		Entity* GetEntity(EntityHandle handle) const;
 		pos_t GetMousePos() const;
 		TCOD_Context* GetContext() const;
 		const Configuration& GetConfig() const;
 		const TCOD_ViewportOptions& GetViewportOptions() const;
 		const EntityManager& GetEntities() const;
+		// Read-only view for instrumentation such as the allocation
+		// check in bench/
+		const EventQueue& GetEventQueue() const
+		{
+			return eventQueue_;
+		}
 		EventHandler* GetEventHandler() const
 		{
 			return eventHandler_.get();
@@ -141,13 +153,41 @@ namespace tutorial
 		{
 			return *map_;
 		}
+		// Whether entity can see the player from where it stands. Uses
+		// the player's own FOV when it is symmetric, otherwise the
+		// batched monster views from the start of the enemy turn.
+		bool CanSeePlayer(const Entity& entity) const;
+		// Awake actors are on the turn schedule. Dormant ones cost
+		// nothing per turn until sight, scent or noise wakes them.
+		bool IsAwake(const Entity& entity) const;
+		void WakeActor(Entity& entity);
+		void PutToSleep(Entity& entity);
+		// Wake every actor within radius of origin and let its AI
+		// know where the sound came from
+		void MakeNoise(pos_t origin, float radius);
+		// Ray tables and cached answers for targeting
+		LineOfSight& GetLineOfSight()
+		{
+			return lineOfSight_;
+		}
+		// Distances to the player, refreshed once per enemy turn
+		const FlowField& GetPlayerFlowField() const
+		{
+			return playerFlowField_;
+		}
+		// Routes actors keep planning toward the same goal. Safe to
+		// use from the enemy planning workers.
+		PathCache& GetPathCache() const
+		{
+			return pathCache_;
+		}
 		int GetMaxRenderPriorityAtPosition(pos_t pos) const;
 		bool IsBlocker(pos_t pos) const;
 		bool IsInBounds(pos_t pos) const;
 		bool IsInFov(pos_t pos) const;
 		bool IsPlayer(const Entity& entity) const;
 		bool IsRunning() const;
-		bool IsValid(Entity& entity) const;
+		bool IsValid(EntityHandle handle) const;
 		bool IsGameOver() const
 		{
 			return gameOver_;
@@ -173,7 +213,7 @@ namespace tutorial
 		{
 			entities_.Clear();
 			messageLog_.Clear();
-			eventQueue_.clear();
+			eventQueue_.Clear();
 			entitiesToRemove_.clear();
 		}
 
@@ -187,10 +227,14 @@ namespace tutorial
 		friend class UseItemCommand;
 		friend class DropItemCommand;
 		friend class SaveManager;
-		void AddEvent(Event_ptr& event);
-		void GenerateMap(int width, int height);
+		void AddEvent(ActionRecord action);
+		void GenerateMap();
 		void ProcessDeferredRemovals();
 		void EnsureInitialized();
+		void UpdatePlayerFlowField();
+		void UpdateMonsterVisibility();
+		// Wake the dormant actors near enough to notice the player
+		void WakeNearbyActors();
 
 		// Rendering helpers
 		void RenderGame();
@@ -233,6 +277,10 @@ namespace tutorial
 		void RestorePlayerWithState(PlayerState&& state,
 		                            pos_t position);
 		void RecreatePlayerUI();
+		// Start building the level below this one in the background
+		void PrefetchNextLevel();
+		// Swap in a prefetched level after ClearCurrentLevel
+		void AdoptPreparedLevel(PreparedLevel& level);
 		pos_t CalculateWindowPosition(int width, int height,
 		                              bool center) const;
 
@@ -243,8 +291,12 @@ namespace tutorial
 		LevelConfig currentLevel_;
 
 		EntityManager entities_;
-		std::deque<Event_ptr> eventQueue_;
-		std::vector<Entity*> entitiesToRemove_;
+		EventQueue eventQueue_;
+		std::vector<EntityHandle> entitiesToRemove_;
+		std::vector<EntityId> visibleIds_; // RenderGame scratch
+		// Area query scratch for waking and monster visibility
+		std::vector<Entity*> nearbyActors_;
+		std::vector<VisibilityService::Viewer> viewers_;
 
 		MessageLog messageLog_;
 
@@ -260,11 +312,15 @@ namespace tutorial
 			int selectedClass = 0; // 0=Warrior, 1=Rogue, 2=Mage
 		} characterCreation_;
 
-		Entity* player_;
+		EntityHandle player_;
 		std::unique_ptr<HealthBar> healthBar_;
+		FlowField playerFlowField_;
+		mutable PathCache pathCache_;
+		VisibilityService monsterVisibility_;
+		LineOfSight lineOfSight_;
+		LevelPrefetcher levelPrefetcher_;
 
-		Entity* stairs_;   // Pointer to stairs entity (not owned, just
-		                   // referenced)
+		EntityHandle stairs_;
 		int dungeonLevel_; // Current dungeon depth (starts at 1)
 		int turnsSinceLastAutosave_;
 
@@ -286,7 +342,7 @@ namespace tutorial
 
 		pos_t mousePos_;
 		InventoryMode inventoryMode_;
-		std::vector<Entity*> itemSelectionList_;
+		std::vector<EntityHandle> itemSelectionList_;
 	};
 } // namespace tutorial
 
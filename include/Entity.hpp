@@ -3,6 +3,7 @@
 
 #include "AiComponent.hpp"
 #include "Components.hpp"
+#include "EntityHandle.hpp"
 #include "Item.hpp"
 #include "Position.hpp"
 #include "RenderLayer.hpp"
@@ -15,6 +16,7 @@ class Item; // Forward declaration
 namespace tutorial
 {
 	class SpellcasterComponent;
+	struct ComponentStore;
 
 	enum class Faction { PLAYER, MONSTER, NEUTRAL };
 
@@ -49,10 +51,22 @@ namespace tutorial
 		virtual void SetRenderPriority(int priority) = 0;
 		virtual int GetStackCount() const = 0;
 		virtual void SetStackCount(int count) = 0;
+		// Actions per player turn, scaled so TurnScheduler's
+		// kNormalSpeed is one
+		virtual int GetSpeed() const = 0;
+		virtual void SetSpeed(int speed) = 0;
 		virtual const std::string& GetPluralName() const = 0;
 		virtual void SetPluralName(const std::string& pluralName) = 0;
 		virtual const std::string& GetTemplateId() const = 0;
 		virtual void SetTemplateId(const std::string& templateId) = 0;
+		virtual EntityHandle GetHandle() const = 0;
+		virtual void SetHandle(EntityHandle handle) = 0;
+
+		// Hand the components over to store on spawn, filed under
+		// the handle's index, and take them back on removal. While
+		// attached every getter reads through to the store.
+		virtual void AttachComponents(ComponentStore& store) = 0;
+		virtual void DetachComponents() = 0;
 
 		// Null-safety helpers - throw if component doesn't exist
 		AttackerComponent& RequireAttacker() const
@@ -121,6 +135,11 @@ namespace tutorial
 	 * - If pickable_ is true, the entity can be picked up (requires Item
 	 * component)
 	 * - If isCorpse_ is true, the entity renders on CORPSES layer
+	 *
+	 * Storage:
+	 * - Position, renderable, destructible, attacker and spellcaster
+	 * move into the owning EntityManager's ComponentStore on spawn;
+	 * the entity is then a facade over the pools
 	 */
 	class BaseEntity : public Entity
 	{
@@ -158,12 +177,18 @@ namespace tutorial
 		virtual void SetRenderPriority(int priority) override;
 		virtual int GetStackCount() const override;
 		virtual void SetStackCount(int count) override;
+		virtual int GetSpeed() const override;
+		virtual void SetSpeed(int speed) override;
 		virtual const std::string& GetPluralName() const override;
 		virtual void SetPluralName(
 		    const std::string& pluralName) override;
 		virtual const std::string& GetTemplateId() const override;
 		virtual void SetTemplateId(
 		    const std::string& templateId) override;
+		virtual EntityHandle GetHandle() const override;
+		virtual void SetHandle(EntityHandle handle) override;
+		virtual void AttachComponents(ComponentStore& store) override;
+		virtual void DetachComponents() override;
 		void SetSpellcaster(
 		    std::unique_ptr<SpellcasterComponent> spellcaster);
 
@@ -171,18 +196,23 @@ namespace tutorial
 		std::string name_;
 		std::string pluralName_;
 		std::string templateId_;
+		// Components are owned here only while detached; once spawned
+		// they live in store_ and these are empty
+		ComponentStore* store_;
 		std::unique_ptr<IconRenderable> renderable_;
 		std::unique_ptr<DestructibleComponent> defense_;
 		std::unique_ptr<AttackerComponent> attack_;
 		std::unique_ptr<Item> item_;
 		std::unique_ptr<SpellcasterComponent> spellcaster_;
 		pos_t pos_;
+		EntityHandle handle_; // Null while not owned by EntityManager
 		Faction faction_;
 		bool blocker_;
 		bool pickable_;
 		bool isCorpse_;
 		int renderPriority_; // Higher = renders later (on top)
 		int stackCount_; // Number of items in stack (1 = single item)
+		int speed_;
 	};
 } // namespace tutorial
 
@@ -211,6 +241,10 @@ namespace tutorial
 		    bool isCorpse = false);
 
 		void Act(Engine& engine) override;
+		// Commit a plan the AI made earlier with Decide
+		void Act(Engine& engine, const AiIntent& intent);
+		void AttachComponents(ComponentStore& store) override;
+		void DetachComponents() override;
 		std::unique_ptr<AiComponent> SwapAi(
 		    std::unique_ptr<AiComponent> newAi);
 
@@ -0,0 +1,37 @@
+#ifndef ENTITY_HANDLE_HPP
+#define ENTITY_HANDLE_HPP
+
+#include <cstdint>
+
+namespace tutorial
+{
+	// Generation-checked reference to an entity owned by EntityManager.
+	// The index selects a slot, the generation must match the slot's
+	// current generation for the handle to resolve. Removing an entity
+	// bumps its slot generation, so stale handles resolve to nullptr
+	// instead of dangling.
+	struct EntityHandle {
+		static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+		std::uint32_t index = kInvalidIndex;
+		std::uint32_t generation = 0;
+
+		constexpr bool IsNull() const
+		{
+			return index == kInvalidIndex;
+		}
+	};
+
+	constexpr bool operator==(EntityHandle lhs, EntityHandle rhs)
+	{
+		return (lhs.index == rhs.index
+		        && lhs.generation == rhs.generation);
+	}
+
+	constexpr bool operator!=(EntityHandle lhs, EntityHandle rhs)
+	{
+		return !(lhs == rhs);
+	}
+} // namespace tutorial
+
+#endif // ENTITY_HANDLE_HPP
@@ -1,17 +1,28 @@
 #ifndef ENTITY_MANAGER_HPP
 #define ENTITY_MANAGER_HPP
 
+#include "ComponentStore.hpp"
 #include "Entity.hpp"
+#include "EntityHandle.hpp"
 #include "Position.hpp"
+#include "RenderLayer.hpp"
 #include "Room.hpp"
+#include "TurnScheduler.hpp"
 
 namespace tutorial
 {
+	class DynamicSpawnSystem;
+	struct LevelConfig;
 	struct SpawnConfig;
 }
 
-#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace tutorial
 {
@@ -21,74 +32,295 @@ namespace tutorial
 
 	public:
 		void Clear();
-		void PlaceEntities(const Room& room,
-		                   const SpawnConfig& spawnConfig,
-		                   const std::string& levelId);
-		void PlaceItems(const Room& room,
-		                const SpawnConfig& spawnConfig,
-		                const std::string& levelId);
-		void SortByRenderLayer();
-		Entity_ptr& Spawn(Entity_ptr&& src);
-		Entity_ptr& Spawn(Entity_ptr&& src, pos_t pos);
+		// Size the per-tile occupancy index to the map dimensions
+		void Resize(int width, int height);
+		// Roll items, then monsters, for every room and spawn them as
+		// one batch. Candidate tiles are checked against occupancy
+		// bitmaps, so cost does not grow as the level fills up.
+		void PopulateRooms(std::vector<Room>::const_iterator first,
+		                   std::vector<Room>::const_iterator last,
+		                   const LevelConfig& level);
+		// The batch PopulateRooms would spawn, rolled from spawns'
+		// tables and left unowned. Only reads shared state (the
+		// template registry), so a detached manager can plan a level
+		// off the main thread.
+		std::vector<Entity_ptr> RollRooms(
+		    std::vector<Room>::const_iterator first,
+		    std::vector<Room>::const_iterator last,
+		    const LevelConfig& level,
+		    const DynamicSpawnSystem& spawns) const;
+		Entity* Spawn(Entity_ptr&& src);
+		Entity* Spawn(Entity_ptr&& src, pos_t pos);
+		void SpawnBatch(std::vector<Entity_ptr>&& batch);
 
-		Entity* GetBlockingEntity(pos_t pos) const;
-		std::unique_ptr<Entity> Remove(Entity* entity);
+		// Resolve a handle, nullptr if the entity has been removed
+		Entity* Get(EntityHandle handle) const;
+		bool IsValid(EntityHandle handle) const;
+		// Entity filed under id in the component pools, or nullptr
+		Entity* GetById(EntityId id) const;
+
+		// Pooled components of every owned entity, for systems that
+		// sweep one or two component types across the whole level
+		ComponentStore& GetComponents()
+		{
+			return components_;
+		}
 
-		using iterator = std::deque<Entity_ptr>::iterator;
-		using const_iterator = std::deque<Entity_ptr>::const_iterator;
-		using reverse_iterator =
-		    std::deque<Entity_ptr>::reverse_iterator;
-		using const_reverse_iterator =
-		    std::deque<Entity_ptr>::const_reverse_iterator;
+		const ComponentStore& GetComponents() const
+		{
+			return components_;
+		}
 
-		iterator begin()
+		// When each awake actor acts next. Actors are spawned
+		// dormant, off the schedule, until the engine wakes them;
+		// removal takes them off it.
+		TurnScheduler& GetScheduler()
 		{
-			return entities_.begin();
+			return scheduler_;
 		}
 
-		iterator end()
+		const TurnScheduler& GetScheduler() const
 		{
-			return entities_.end();
+			return scheduler_;
 		}
 
+		// Reorder ids bottom layer first, as iteration would meet
+		// them. Cheaper than walking the buckets when only a few of
+		// the entities are wanted.
+		void SortByRenderOrder(std::vector<EntityId>& ids) const;
+
+		// Move an entity and keep the occupancy index in sync. Entities
+		// owned by the manager must be moved through here, not through
+		// Entity::SetPos directly.
+		void SetPos(Entity& entity, pos_t pos);
+
+		// Per-tile queries, O(entities on the tile)
+		Entity* GetBlockingEntity(pos_t pos) const;
+		Entity* GetActor(pos_t pos) const;
+		int GetMaxRenderPriority(pos_t pos) const;
+		const std::vector<Entity*>& GetEntitiesAt(pos_t pos) const;
+
+		// Area queries over a uniform grid of kCellSize buckets, so
+		// cost follows local density rather than level population.
+		// Matches are appended to out in no particular order.
+		void QueryRect(pos_t min, pos_t max,
+		               std::vector<Entity*>& out) const;
+		// Euclidean radius, compared on squared integer distances
+		void QueryRadius(pos_t center, float radius,
+		                 std::vector<Entity*>& out) const;
+		// Closest entity accepted by filter, searching outward ring by
+		// ring. A range of 0 means unlimited. nullptr if none.
+		Entity* Nearest(
+		    pos_t center, float range,
+		    const std::function<bool(const Entity&)>& filter) const;
+
+		std::unique_ptr<Entity> Remove(EntityHandle handle);
+
+		// Render-order bucket for a single RenderLayer. Ties on
+		// priority fall back to spawn order, matching the old stable
+		// sort.
+		struct RenderKey {
+			int priority;
+			std::uint64_t sequence;
+
+			bool operator<(const RenderKey& other) const
+			{
+				return (priority != other.priority)
+				           ? priority < other.priority
+				           : sequence < other.sequence;
+			}
+		};
+
+		using RenderBucket = std::map<RenderKey, Entity*>;
+		using RenderBuckets = std::map<RenderLayer, RenderBucket>;
+
+		// Bidirectional iterator walking the buckets bottom layer
+		// first. Empty buckets are erased, so every bucket reached is
+		// non-empty.
+		class const_iterator
+		{
+		public:
+			using iterator_category =
+			    std::bidirectional_iterator_tag;
+			using value_type = Entity*;
+			using difference_type = std::ptrdiff_t;
+			using pointer = Entity* const*;
+			using reference = Entity* const&;
+
+			const_iterator() = default;
+
+			const_iterator(const RenderBuckets* buckets,
+			               RenderBuckets::const_iterator layer)
+			    : buckets_(buckets), layer_(layer)
+			{
+				if (layer_ != buckets_->end()) {
+					item_ = layer_->second.begin();
+				}
+			}
+
+			reference operator*() const
+			{
+				return item_->second;
+			}
+
+			pointer operator->() const
+			{
+				return &item_->second;
+			}
+
+			const_iterator& operator++()
+			{
+				if (++item_ == layer_->second.end()) {
+					if (++layer_ != buckets_->end()) {
+						item_ = layer_->second.begin();
+					}
+				}
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			const_iterator& operator--()
+			{
+				if (layer_ == buckets_->end()
+				    || item_ == layer_->second.begin()) {
+					--layer_;
+					item_ = layer_->second.end();
+				}
+				--item_;
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return (layer_ == other.layer_
+				        && (layer_ == buckets_->end()
+				            || item_ == other.item_));
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+		private:
+			const RenderBuckets* buckets_ = nullptr;
+			RenderBuckets::const_iterator layer_;
+			RenderBucket::const_iterator item_;
+		};
+
+		// Entities are mutable through the stored pointers, so plain
+		// iteration shares the const iterator
+		using iterator = const_iterator;
+		using reverse_iterator = std::reverse_iterator<const_iterator>;
+		using const_reverse_iterator = reverse_iterator;
+
+		// Iteration yields entities in render order: by RenderLayer,
+		// then render priority, then spawn order
 		const_iterator begin() const
 		{
-			return entities_.begin();
+			return const_iterator(&buckets_, buckets_.begin());
 		}
 
 		const_iterator end() const
 		{
-			return entities_.end();
+			return const_iterator(&buckets_, buckets_.end());
 		}
 
-		// ADD THESE FOUR METHODS:
-		reverse_iterator rbegin()
+		const_reverse_iterator rbegin() const
 		{
-			return entities_.rbegin();
+			return const_reverse_iterator(end());
 		}
 
-		reverse_iterator rend()
+		const_reverse_iterator rend() const
 		{
-			return entities_.rend();
+			return const_reverse_iterator(begin());
 		}
 
-		const_reverse_iterator rbegin() const
+		std::size_t size() const
 		{
-			return entities_.rbegin();
+			return size_;
 		}
 
-		const_reverse_iterator rend() const
+		bool empty() const
 		{
-			return entities_.rend();
+			return size_ == 0;
 		}
 
 	private:
-		void PlaceEntitiesFromTable(
-		    const Room& room, const class SpawnTable* table,
-		    const SpawnConfig& spawnConfig,
-		    bool checkBlockingOnly);
+		// Tiles already claimed while planning a batch: any entity
+		// (items avoid these) and blocking entities (monsters avoid
+		// these)
+		struct SpawnPlan {
+			std::vector<bool> occupied;
+			std::vector<bool> blocked;
+			std::vector<Entity_ptr> batch;
+		};
+
+		void PlanFromTable(const Room& room,
+		                   const class SpawnTable* table,
+		                   const SpawnConfig& spawnConfig,
+		                   bool checkBlockingOnly,
+		                   SpawnPlan& plan) const;
+
+		bool IsIndexed(pos_t pos) const;
+		void AddToIndex(Entity* entity);
+		void RemoveFromIndex(Entity* entity);
+
+		// Slot map storage. A slot's generation is bumped whenever its
+		// entity is removed, invalidating outstanding handles.
+		struct Slot {
+			Entity_ptr entity;
+			std::uint32_t generation = 0;
+
+			// Bucket position captured at spawn, so removal is an
+			// exact O(log n) erase
+			RenderLayer layer = RenderLayer::CORPSES;
+			RenderKey renderKey { 0, 0 };
+		};
+
+		void AddToBuckets(Slot& slot);
+		void RemoveFromBuckets(const Slot& slot);
+
+		std::vector<Slot> slots_;
+		std::vector<std::uint32_t> freeSlots_;
+
+		// Components of live entities, keyed by slot index
+		ComponentStore components_;
+		TurnScheduler scheduler_;
+
+		// Live entities in render order. RenderLayer and render
+		// priority are read once at spawn time; set them before
+		// spawning.
+		RenderBuckets buckets_;
+		std::uint64_t nextSequence_ = 0;
+		std::size_t size_ = 0;
+
+		// Occupancy index: every entity on each tile, plus the blocking
+		// entity (if any) so movement checks are a single lookup
+		std::vector<std::vector<Entity*>> occupants_;
+		std::vector<Entity*> blockers_;
+
+		// Spatial hash: entities bucketed by kCellSize square cells
+		static constexpr int kCellSize = 8;
+		std::vector<std::vector<Entity*>> cells_;
+		int cellsWide_ = 0;
+		int cellsHigh_ = 0;
 
-		std::deque<Entity_ptr> entities_;
+		int width_ = 0;
+		int height_ = 0;
 	};
 } // namespace tutorial
 
@@ -58,6 +58,7 @@ namespace tutorial
 		int defense;
 		int power;
 		int xp; // XP reward when killed
+		int speed; // TurnScheduler speed, 100 = normal
 
 		// AI type (e.g., "hostile")
 		std::string ai;
@@ -112,6 +113,7 @@ namespace tutorial
 		int defense;
 		int power;
 		int xpReward;
+		int speed; // TurnScheduler speed, 100 = normal
 
 		// AI type
 		std::optional<std::string>
@@ -1,7 +1,9 @@
 #ifndef EVENT_HPP
 #define EVENT_HPP
 
+#include "AiComponent.hpp"
 #include "Colors.hpp"
+#include "EntityHandle.hpp"
 #include "Position.hpp"
 
 namespace tutorial
@@ -75,24 +77,31 @@ namespace tutorial
 	class Action : public Event
 	{
 	public:
-		Action(Engine& engine, Entity& entity)
-		    : engine_(engine), entity_(entity)
-		{
-		}
+		Action(Engine& engine, Entity& entity);
 
-		virtual void Execute();
+		virtual void Execute() = 0;
 
 	protected:
+		// Resolve the acting entity, nullptr if it has been removed
+		// since the action was queued
+		Entity* GetEntity() const;
+
 		Engine& engine_;
-		Entity& entity_;
+		EntityHandle entity_;
 	};
 
+	// One actor's AI turn: commits intent, planned earlier in the
+	// turn, or runs the AI outright if nothing was planned
 	class AiAction final : public Action
 	{
 	public:
-		AiAction(Engine& engine, Entity& entity);
+		AiAction(Engine& engine, Entity& entity,
+		         const AiIntent& intent = AiIntent {});
 
 		void Execute() override;
+
+	private:
+		AiIntent intent_;
 	};
 
 	class DieAction final : public Action
@@ -160,12 +169,13 @@ namespace tutorial
 	class PickupItemAction final : public Action
 	{
 	public:
-		PickupItemAction(Engine& engine, Entity& entity, Entity* item);
+		PickupItemAction(Engine& engine, Entity& entity,
+		                 EntityHandle item);
 
 		void Execute() override;
 
 	private:
-		Entity* item_;
+		EntityHandle item_;
 	};
 
 	class UseItemAction final : public Action
@@ -0,0 +1,69 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+
+#include "Event.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace tutorial
+{
+	// Any action that can wait in the engine's queue, stored by value
+	using ActionRecord =
+	    std::variant<AiAction, WaitAction, BumpAction, MeleeAction,
+	                 MoveAction, PickupAction, PickupItemAction,
+	                 DropItemAction>;
+
+	// Run the action held in record
+	void Execute(ActionRecord& record);
+
+	// Double-ended ring buffer of action records. Slots are reused turn
+	// after turn, so once the buffer has grown to the busiest turn seen
+	// queueing an action never touches the heap.
+	class EventQueue
+	{
+	public:
+		EventQueue();
+
+		void PushBack(ActionRecord record);
+		void PushFront(ActionRecord record);
+		// Remove and return the front record; the queue must not be
+		// empty
+		ActionRecord PopFront();
+		void Clear();
+
+		bool empty() const
+		{
+			return count_ == 0;
+		}
+
+		std::size_t size() const
+		{
+			return count_;
+		}
+
+		std::size_t GetCapacity() const
+		{
+			return slots_.size();
+		}
+
+		// Heap allocations made by the buffer since construction,
+		// including the first
+		std::size_t GetAllocationCount() const
+		{
+			return allocations_;
+		}
+
+	private:
+		void Grow();
+
+		std::vector<std::optional<ActionRecord>> slots_;
+		std::size_t head_ = 0;
+		std::size_t count_ = 0;
+		std::size_t allocations_ = 0;
+	};
+} // namespace tutorial
+
+#endif // EVENT_QUEUE_HPP
@@ -0,0 +1,50 @@
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+
+#include "Position.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace tutorial
+{
+	class Map;
+
+	// Dijkstra map over walkable tiles, rooted at a single goal. Every
+	// chaser reads its next step from the same field instead of tracing
+	// its own line, so a turn costs one flood fill no matter how many
+	// monsters are hunting.
+	//
+	// Movement is 8-way with uniform cost, matching MoveAction, so
+	// distances are in steps (Chebyshev on open ground).
+	class FlowField
+	{
+	public:
+		static constexpr std::uint16_t kUnreachable = 0xFFFF;
+
+		// Refill only if the goal moved or the terrain changed since
+		// the last fill. Returns true if a refill happened.
+		bool Update(const Map& map, pos_t goal);
+
+		// Steps from pos to the goal, kUnreachable if none
+		std::uint16_t GetDistance(pos_t pos) const;
+
+		pos_t GetGoal() const
+		{
+			return goal_;
+		}
+
+	private:
+		void Rebuild(const Map& map);
+
+		std::vector<std::uint16_t> distances_;
+		std::vector<int> frontier_;
+		const Map* map_ = nullptr;
+		unsigned int terrainVersion_ = 0;
+		pos_t goal_ { -1, -1 };
+		int width_ = 0;
+		int height_ = 0;
+	};
+} // namespace tutorial
+
+#endif // FLOW_FIELD_HPP
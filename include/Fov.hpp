@@ -0,0 +1,33 @@
+#ifndef FOV_HPP
+#define FOV_HPP
+
+#include "BitGrid.hpp"
+#include "Position.hpp"
+
+namespace tutorial
+{
+	enum class FovAlgorithm {
+		// libtcod's FOV_RESTRICTIVE via TCOD_map_compute_fov
+		Restrictive,
+		// Native symmetric shadowcasting on Map's bitplanes
+		Shadowcast
+	};
+
+	// Symmetric shadowcasting: if A can see B then B can see A, and
+	// walls bounding a lit area are lit. Reads opacity from the
+	// transparent plane and sets bits in visible (never clears them).
+	// radius <= 0 means unlimited; otherwise the lit area is a disc.
+	void ComputeShadowcastFov(const BitGrid& transparent, int width,
+	                          int height, pos_t origin, int radius,
+	                          BitGrid& visible);
+
+	// As above, but visible covers only the window of windowSize tiles
+	// whose top-left map tile is windowOrigin. Lit tiles outside the
+	// window are dropped.
+	void ComputeShadowcastFov(const BitGrid& transparent, int width,
+	                          int height, pos_t origin, int radius,
+	                          BitGrid& visible, pos_t windowOrigin,
+	                          pos_t windowSize);
+} // namespace tutorial
+
+#endif // FOV_HPP
@@ -1,6 +1,7 @@
 #ifndef ITEM_SELECTION_WINDOW_HPP
 #define ITEM_SELECTION_WINDOW_HPP
 
+#include "EntityHandle.hpp"
 #include "Position.hpp"
 #include "UiWindow.hpp"
 
@@ -12,21 +13,22 @@
 
 namespace tutorial
 {
-	class Entity;
+	class EntityManager;
 
 	// Generic window for selecting items from a list
 	class ItemSelectionWindow : public UiWindowBase
 	{
 	public:
 		ItemSelectionWindow(std::size_t width, std::size_t height,
-		                    pos_t pos,
-		                    const std::vector<Entity*>& items,
+		                    pos_t pos, const EntityManager& entities,
+		                    const std::vector<EntityHandle>& items,
 		                    const std::string& title);
 
 		void Render(TCOD_Console* parent) const override;
 
 	private:
-		const std::vector<Entity*>& items_;
+		const EntityManager& entities_;
+		const std::vector<EntityHandle>& items_;
 		std::string title_;
 	};
 } // namespace tutorial
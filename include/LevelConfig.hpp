@@ -47,6 +47,10 @@ namespace tutorial
 
 		// Load from JSON object (for when JSON is already parsed)
 		static LevelConfig FromJson(const nlohmann::json& j);
+
+		// Load the config for a dungeon depth, falling back to
+		// dungeon_1 if its file cannot be read
+		static LevelConfig LoadForDepth(int dungeonLevel);
 	};
 } // namespace tutorial
 
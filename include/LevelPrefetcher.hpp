@@ -0,0 +1,76 @@
+#ifndef LEVEL_PREFETCHER_HPP
+#define LEVEL_PREFETCHER_HPP
+
+#include "Entity.hpp"
+#include "LevelConfig.hpp"
+#include "Position.hpp"
+#include "ScentField.hpp"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace tutorial
+{
+	class DynamicSpawnSystem;
+	class Map;
+
+	// A dungeon level built away from the engine, ready to be swapped
+	// in: its config, its generated map, the entities rolled for its
+	// rooms and its stairs, none of them owned by an EntityManager yet
+	struct PreparedLevel {
+		int dungeonLevel = 0;
+		LevelConfig config;
+		std::unique_ptr<Map> map;
+		std::vector<std::unique_ptr<Entity>> entities;
+		std::unique_ptr<Entity> stairs;
+	};
+
+	// Builds the next dungeon level on a background thread while the
+	// current one is played, so descending only has to swap it in.
+	// The level config and its spawn tables are loaded by Start on the
+	// calling thread, so their log lines stay in order with the game's.
+	// The build then draws from the level's own random streams. The
+	// only shared state it touches is the template registry, which it
+	// reads and which must not be reloaded while a build is pending.
+	class LevelPrefetcher
+	{
+	public:
+		LevelPrefetcher() = default;
+		~LevelPrefetcher();
+
+		LevelPrefetcher(const LevelPrefetcher&) = delete;
+		LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+		// Load dungeonLevel's config and start building the level,
+		// replacing any pending build
+		void Start(int dungeonLevel, std::uint64_t masterSeed,
+		           pos_t mapSize,
+		           const ScentField::Config& scentConfig);
+
+		// The level built for dungeonLevel, waiting for it if still
+		// running. nullptr if nothing matching was pending or the
+		// build failed; the caller then generates it directly.
+		std::unique_ptr<PreparedLevel> Take(int dungeonLevel);
+
+		// Drop any pending build, waiting for it to stop
+		void Cancel();
+
+		// Build a level from its loaded config and spawn tables on
+		// the calling thread
+		static std::unique_ptr<PreparedLevel> Build(
+		    int dungeonLevel, LevelConfig config,
+		    const DynamicSpawnSystem& spawns, std::uint64_t masterSeed,
+		    pos_t mapSize, const ScentField::Config& scentConfig);
+
+		// Run the level's generator over map
+		static void GenerateMap(Map& map, const LevelConfig& level);
+
+	private:
+		std::future<std::unique_ptr<PreparedLevel>> pending_;
+		int pendingLevel_ = 0;
+	};
+} // namespace tutorial
+
+#endif // LEVEL_PREFETCHER_HPP
@@ -0,0 +1,53 @@
+#ifndef LINE_OF_SIGHT_HPP
+#define LINE_OF_SIGHT_HPP
+
+#include "Position.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tutorial
+{
+	class Map;
+
+	// Line-of-sight queries for targeting. Rays are precomputed once as
+	// relative offsets (the exact tiles tcod::BresenhamLine would visit)
+	// for every target within range, so a query is a walk over a table
+	// instead of a fresh line. Answers are cached by (origin, target)
+	// until the terrain changes.
+	class LineOfSight
+	{
+	public:
+		// Tiles after the origin up to and including the target
+		using Ray = std::pair<const pos_t*, const pos_t*>;
+
+		// Precompute rays for every target within range tiles
+		void Reserve(int range);
+
+		// Relative ray from (0, 0) to delta; grows the table if needed
+		Ray GetRay(pos_t delta);
+
+		// Whether every tile strictly between origin and target is
+		// transparent
+		bool HasLineOfSight(const Map& map, pos_t origin, pos_t target);
+
+		void Clear();
+
+	private:
+		bool Trace(const Map& map, pos_t origin, pos_t delta);
+
+		static constexpr std::size_t kMaxCachedQueries = 1 << 16;
+
+		int range_ = -1;
+		std::vector<std::uint32_t> offsets_; // (2r+1)^2 + 1 into steps_
+		std::vector<pos_t> steps_;
+
+		std::unordered_map<std::uint64_t, bool> cache_;
+		const Map* map_ = nullptr;
+		unsigned int terrainVersion_ = 0;
+	};
+} // namespace tutorial
+
+#endif // LINE_OF_SIGHT_HPP
@@ -1,12 +1,17 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
+#include "BitGrid.hpp"
+#include "Fov.hpp"
+#include "NavGraph.hpp"
 #include "Position.hpp"
 #include "Room.hpp"
+#include "ScentField.hpp"
 #include "Tile.hpp"
 
 #include <libtcod.h>
 
+#include <mutex>
 #include <vector>
 
 namespace tutorial
@@ -19,21 +24,21 @@ namespace tutorial
 		Map(int width, int height);
 		~Map(); // Now we need destructor to clean up C API resources
 
-		void ComputeFov(pos_t origin, int fovRadius);
+		void ComputeFov(
+		    pos_t origin, int fovRadius,
+		    FovAlgorithm algorithm = FovAlgorithm::Restrictive);
 		void Generate(Generator& generator);
 		void SetExplored(pos_t pos, bool explored);
 		void SetTileType(pos_t pos, TileType type);
 		void AddRoom(const Room& room);
+		// Repaint tiles whose visible/explored/type state changed since
+		// the last call (everything after Generate)
 		void Update();
 		void UpdateScent(
 		    pos_t playerPos); // Update scent field around player
 
 		int GetHeight() const;
 		const std::vector<Room>& GetRooms() const;
-		const std::vector<tile_t>& GetTiles() const
-		{
-			return tiles_;
-		}
 		TileType GetTileType(pos_t pos) const;
 		int GetWidth() const;
 		bool IsExplored(pos_t pos) const;
@@ -43,29 +48,110 @@ namespace tutorial
 		bool IsTransparent(pos_t pos) const;
 		void Render(TCOD_Console* parent) const;
 
+		// Bounds-unchecked accessors by flat tile index for hot loops
+		// that have already validated their range
+		bool IsWalkableAt(int index) const
+		{
+			return walkable_.Get(index);
+		}
+		bool IsTransparentAt(int index) const
+		{
+			return transparent_.Get(index);
+		}
+		bool IsInFovAt(int index) const
+		{
+			return inFov_.Get(index);
+		}
+		bool IsExploredAt(int index) const
+		{
+			return explored_.Get(index);
+		}
+
+		// Whole planes, for word-at-a-time consumers
+		const BitGrid& GetWalkablePlane() const
+		{
+			return walkable_;
+		}
+		const BitGrid& GetTransparentPlane() const
+		{
+			return transparent_;
+		}
+		const BitGrid& GetFovPlane() const
+		{
+			return inFov_;
+		}
+
 		// Scent tracking accessors
 		unsigned int GetScent(pos_t pos) const;
 		unsigned int GetCurrentScentValue() const
 		{
-			return currentScentValue_;
+			return scent_.GetCurrentValue();
+		}
+		const ScentField& GetScentField() const
+		{
+			return scent_;
+		}
+		void SetScentConfig(const ScentField::Config& config)
+		{
+			scent_.SetConfig(config);
+		}
+
+		// Cluster graph for PathAlgorithm::Hierarchical. Built on the
+		// first call after Generate, then patched on later calls for
+		// tiles SetTileType has changed since, so maps that never plan
+		// a hierarchical path never pay for it. Safe to call from
+		// several threads at once, but not alongside SetTileType.
+		const NavGraph& GetNavGraph() const;
+
+		// Changes whenever walkability may have changed, so cached
+		// navigation data can tell when it is stale. Never reused, even
+		// by a different Map.
+		unsigned int GetTerrainVersion() const
+		{
+			return terrainVersion_;
 		}
 
 	private:
 		void Clear();
+		void MarkDirty(int index);
+		void PaintTile(int index);
 
 		std::vector<Room> rooms_;
-		std::vector<tile_t> tiles_;
+
+		// Tile state, one bitplane per flag. Floor/wall type is implied
+		// by walkability.
+		BitGrid walkable_;
+		BitGrid transparent_;
+		BitGrid explored_;
+		BitGrid inFov_;
+		ScentField scent_;
+
+		// Built on demand by GetNavGraph
+		mutable NavGraph navGraph_;
+		mutable std::vector<pos_t> navGraphPending_; // Tiles to patch
+		mutable std::mutex navGraphMutex_;
 
 		// Changed from unique_ptr to raw pointers - we manage lifecycle
-		// manually
+		// manually. console_ caches the painted map; map_ mirrors
+		// walkable_/transparent_ only as input to libtcod's FOV.
 		TCOD_Console* console_;
 		TCOD_Map* map_;
 
 		int width_;
 		int height_;
 
-		// Scent tracking for monster AI
-		unsigned int currentScentValue_;
+		unsigned int terrainVersion_;
+
+		// Incremental repaint state. visible_ lists the tiles in FOV as
+		// of the last ComputeFov so the next FOV can be diffed against
+		// inFov_.
+		std::vector<int> visible_;
+		pos_t fovBoxMin_;
+		pos_t fovBoxMax_;
+		BitGrid fovScratch_; // Next FOV, all clear between calls
+		std::vector<int> dirty_;
+		BitGrid isDirty_;
+		bool fullRepaint_;
 	};
 } // namespace tutorial
 
@@ -0,0 +1,95 @@
+#ifndef NAV_GRAPH_HPP
+#define NAV_GRAPH_HPP
+
+#include "BitGrid.hpp"
+#include "Position.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace tutorial
+{
+	struct PathfindingContext;
+	struct PathfindingStats;
+
+	// HPA*-style abstraction of the walkable plane. The map is cut into
+	// kClusterSize square clusters; every walkable run along a cluster
+	// border contributes one or two entrance tiles on each side, and
+	// each cluster stores the cost between its own entrances. Long
+	// routes are planned over this small graph first and only the legs
+	// inside single clusters are refined on the grid.
+	//
+	// Costs use the same octile units and no-corner-cutting rule as
+	// PathAlgorithm::AStar, searching only tiles inside the cluster.
+	class NavGraph
+	{
+	public:
+		static constexpr int kClusterSize = 16;
+
+		// Full rebuild, done by Map on the first query after Generate
+		void Build(const BitGrid& walkable, int width, int height);
+
+		// Rebuild only the cluster holding pos, plus any neighbour
+		// whose shared border pos lies on. No-op until built.
+		void OnTileChanged(const BitGrid& walkable, pos_t pos);
+
+		void Reset();
+
+		bool IsBuilt() const
+		{
+			return built_;
+		}
+
+		// Inclusive tile bounds of the cluster holding pos
+		void GetClusterBounds(pos_t pos, pos_t& min, pos_t& max) const;
+
+		// Plan start -> goal over the abstract graph. On success,
+		// waypoints holds start, the entrance tiles crossed, then goal;
+		// consecutive waypoints either share a cluster or are
+		// orthogonal neighbours across a border.
+		bool FindAbstractPath(const BitGrid& walkable, pos_t start,
+		                      pos_t goal, PathfindingContext& context,
+		                      std::vector<pos_t>& waypoints,
+		                      PathfindingStats* stats) const;
+
+		std::size_t GetNodeCount() const;
+
+	private:
+		struct Edge {
+			int to; // Tile index of the target entrance
+			int cost;
+		};
+
+		struct Node {
+			int tile;
+			std::vector<Edge> edges;
+		};
+
+		struct Cluster {
+			std::vector<Node> nodes;
+		};
+
+		// Pairs of (tile in this cluster, tile across the border)
+		using Transitions = std::vector<std::pair<int, int>>;
+
+		int ClusterIndex(pos_t pos) const;
+		void BuildCluster(const BitGrid& walkable, int cx, int cy);
+		void CollectTransitions(const BitGrid& walkable, int cx, int cy,
+		                        bool east, Transitions& out) const;
+		// Octile cost from origin to every tile of its cluster, indexed
+		// by position within the cluster bounds. -1 when unreachable.
+		void ClusterDistances(const BitGrid& walkable, pos_t origin,
+		                      std::vector<int>& distances) const;
+
+		std::vector<Cluster> clusters_;
+		std::vector<int> nodeAt_; // Tile -> index in its cluster, or -1
+		int width_ = 0;
+		int height_ = 0;
+		int clustersWide_ = 0;
+		int clustersHigh_ = 0;
+		bool built_ = false;
+	};
+} // namespace tutorial
+
+#endif // NAV_GRAPH_HPP
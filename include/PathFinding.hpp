@@ -3,6 +3,9 @@
 
 #include "Position.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace tutorial
@@ -10,28 +13,138 @@ namespace tutorial
 	// Forward declaration
 	class Map;
 
+	enum class PathAlgorithm {
+		// DCSS-style greedy best-first, 4-way. Cheap, not optimal, and
+		// randomised for organic-looking corridors.
+		BestFirst,
+		// Optimal A* with an octile heuristic, 8-way, no corner
+		// cutting.
+		AStar,
+		// Jump Point Search over the same 8-way uniform-cost grid. Same
+		// paths as AStar, far fewer nodes expanded on open maps.
+		JumpPoint,
+		// HPA* over the map's NavGraph, refined leg by leg with AStar
+		// inside single clusters. Near-optimal; cost grows with the
+		// number of clusters crossed, not the tiles between.
+		Hierarchical
+	};
+
+	// Optional instrumentation filled in by FindPath
+	struct PathfindingStats {
+		int nodesExpanded = 0; // Nodes popped from the open list
+		int nodesTouched = 0;  // Tiles examined, including jump scans
+		int cacheHits = 0;     // PathCache queries answered from a route
+		int cacheMisses = 0;   // PathCache queries that ran a search
+	};
+
 	// Holds pathfinding state - similar to DCSS's travel_point_distance
 	// grid Negative values encode both "visited" status and parent
 	// direction
+	//
+	// A context is reused across queries. Instead of clearing the grid,
+	// each query bumps a generation counter and a cell only counts as
+	// visited if its stamp matches the current generation.
 	struct PathfindingContext {
+		// Open list entry for best-first search
+		struct Node {
+			pos_t pos;
+			int distanceToGoal; // Priority key (f for A*/JPS)
+			int cost = 0;       // Cost from start (A*/JPS only)
+
+			// On equal priority prefer the deeper node, which cuts
+			// A* expansions sharply on open ground
+			bool operator>(const Node& other) const
+			{
+				if (distanceToGoal != other.distanceToGoal) {
+					return distanceToGoal
+					       > other.distanceToGoal;
+				}
+				return cost < other.cost;
+			}
+		};
+
 		std::vector<int> distances;
-		int width;
-		int height;
+		std::vector<int> costs;   // A*/JPS cost from start
+		std::vector<int> parents; // A*/JPS parent tile index
+		std::vector<std::uint32_t> stamps;
+		std::vector<Node> open;
+		std::uint32_t generation = 0;
+		std::uint32_t rngState = 1;
+		int width = 0;
+		int height = 0;
 
+		PathfindingContext() = default;
 		PathfindingContext(int w, int h);
 
-		// Get/set distance value at position
+		// Prepare for a new query on a w x h grid. Only reallocates
+		// when the grid grows; otherwise just invalidates the previous
+		// query.
+		void Begin(int w, int h, std::uint32_t seed);
+
+		// Get/set distance value at position (0 for unvisited cells)
+
 		int GetDistance(pos_t pos) const;
 		void SetDistance(pos_t pos, int value);
 
 		// Check if position is in bounds
 		bool InBounds(pos_t pos) const;
+
+		// xorshift32, cheap enough to call per expanded node
+		std::uint32_t NextRandom();
+
+		// Per-thread context used by FindPath
+		static PathfindingContext& ThreadLocal();
 	};
 
-	// Find path between two points using DCSS-style best-first search
-	// Returns empty vector if no path exists
-	// Path includes start and end positions
-	std::vector<pos_t> FindPath(const Map& map, pos_t start, pos_t end);
+	// Find path between two points, by default using DCSS-style
+	// best-first search. Path includes start and end positions, one tile
+	// per step, and is written into a caller-owned vector so repeated
+	// queries do not allocate. Returns false (and clears path) if no path
+	// exists.
+	//
+	// BestFirst draws from the shared pathfinding stream, so only the
+	// main thread may use it; the other algorithms are safe on workers.
+	bool FindPath(const Map& map, pos_t start, pos_t end,
+	              std::vector<pos_t>& path,
+	              PathAlgorithm algorithm = PathAlgorithm::BestFirst,
+	              PathfindingStats* stats = nullptr);
+
+	// Bounded LRU of routes for callers that plan toward the same goal
+	// over and over. A route is keyed by its goal, algorithm and the
+	// map's terrain version, and answers a query from any tile along it,
+	// so an actor walking its route hits on every step. Entities are not
+	// part of the key; callers recheck the next step against blockers
+	// instead of replanning. Safe to share between threads.
+	class PathCache
+	{
+	public:
+		static constexpr std::size_t kDefaultCapacity = 32;
+
+		explicit PathCache(std::size_t capacity = kDefaultCapacity);
+
+		// FindPath through the cache. On a miss the search runs
+		// outside the lock and its route is stored.
+		bool FindPath(const Map& map, pos_t start, pos_t end,
+		              std::vector<pos_t>& path,
+		              PathAlgorithm algorithm,
+		              PathfindingStats* stats = nullptr);
+
+		void Clear();
+
+	private:
+		struct Entry {
+			pos_t end { 0, 0 };
+			PathAlgorithm algorithm = PathAlgorithm::AStar;
+			unsigned int terrainVersion = 0;
+			std::uint64_t lastUsed = 0;
+			std::vector<pos_t> route;
+		};
+
+		std::vector<Entry> entries_;
+		std::size_t capacity_;
+		std::uint64_t clock_ = 0;
+		std::mutex mutex_;
+	};
 
 } // namespace tutorial
 
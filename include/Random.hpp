@@ -0,0 +1,113 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tutorial
+{
+	// Independent generator streams, one per subsystem, so draws in one
+	// never shift the sequence seen by another
+	enum class RandomStream {
+		Generation, // Map layout
+		Spawning,   // Spawn rolls and spawn table picks
+		Pathfinding,
+		Ai,
+		Count
+	};
+
+	// xoshiro256** generator. Small, fast and copyable, so a stream can
+	// be handed to another thread by value.
+	class Rng
+	{
+	public:
+		explicit Rng(std::uint64_t seed = 0);
+
+		std::uint64_t Next();
+
+		// Uniform in [min, max]; the bounds may come in either order
+		int GetInt(int min, int max);
+		float GetFloat(float min, float max);
+
+		// A new generator seeded from this one's output, independent of
+		// every later draw from either
+		Rng Split();
+
+	private:
+		std::array<std::uint64_t, 4> state_;
+	};
+
+	// Owner of the master seed and of the streams the main thread draws
+	// from. The master seed is all a save needs to replay generation.
+	class RandomService
+	{
+	public:
+		static RandomService& Instance();
+
+		// Reseed every stream from masterSeed
+		void Seed(std::uint64_t masterSeed);
+
+		std::uint64_t GetMasterSeed() const
+		{
+			return masterSeed_;
+		}
+
+		// The shared stream. Main thread only; other threads take a
+		// ForLevel stream or a Split copy.
+		Rng& Get(RandomStream stream)
+		{
+			return streams_[static_cast<std::size_t>(stream)];
+		}
+
+		// Stream for one dungeon level. The same seed, stream and level
+		// always give the same sequence, whichever thread draws it and
+		// whatever was drawn before.
+		static Rng ForLevel(std::uint64_t masterSeed,
+		                    RandomStream stream, int dungeonLevel);
+
+	private:
+		RandomService();
+
+		std::uint64_t masterSeed_ = 0;
+		std::array<Rng, static_cast<std::size_t>(RandomStream::Count)>
+		    streams_;
+	};
+
+	// Generator for stream on the calling thread: the innermost active
+	// ScopedRandom for it, else the shared RandomService stream
+	Rng& GetRandom(RandomStream stream);
+
+	// Redirect GetRandom(stream) on the current thread for this object's
+	// lifetime
+	class ScopedRandom
+	{
+	public:
+		ScopedRandom(RandomStream stream, Rng& rng);
+		~ScopedRandom();
+
+		ScopedRandom(const ScopedRandom&) = delete;
+		ScopedRandom& operator=(const ScopedRandom&) = delete;
+
+	private:
+		RandomStream stream_;
+		Rng* previous_;
+	};
+
+	// Generation and spawning streams for one dungeon level, active on
+	// the current thread, so a level comes out the same whether it is
+	// built ahead of time, on descent or when a save is reloaded
+	class ScopedLevelRandom
+	{
+	public:
+		ScopedLevelRandom(std::uint64_t masterSeed, int dungeonLevel);
+
+	private:
+		Rng generation_;
+		Rng spawning_;
+		ScopedRandom generationScope_;
+		ScopedRandom spawningScope_;
+	};
+} // namespace tutorial
+
+#endif // RANDOM_HPP
@@ -0,0 +1,64 @@
+#ifndef SCENT_FIELD_HPP
+#define SCENT_FIELD_HPP
+
+#include "BitGrid.hpp"
+#include "Position.hpp"
+
+#include <vector>
+
+namespace tutorial
+{
+	// Player scent, stored row-major as "turn stamp minus distance" so a
+	// higher value is a fresher, closer trail. All updates are bounded
+	// by the FOV box (plus the diffusion range), never the whole map.
+	class ScentField
+	{
+	public:
+		struct Config {
+			// Spread scent to adjacent walkable tiles each turn so
+			// it leaks along corridors out of sight
+			bool diffusion = false;
+			// How far outside the FOV box diffusion may reach
+			int diffusionRange = 8;
+		};
+
+		void Resize(int width, int height);
+
+		// Advance the scent clock and lay fresh scent on every visible
+		// tile inside [boxMin, boxMax]
+		void Deposit(const BitGrid& fov, pos_t boxMin, pos_t boxMax,
+		             pos_t source);
+
+		// One relaxation pass: each walkable tile takes the strongest
+		// 4-way neighbour's scent minus one, if that is stronger
+		void Diffuse(const BitGrid& walkable, pos_t boxMin,
+		             pos_t boxMax, int range);
+
+		void SetConfig(const Config& config)
+		{
+			config_ = config;
+		}
+		const Config& GetConfig() const
+		{
+			return config_;
+		}
+
+		// 0 outside the field
+		unsigned int Get(pos_t pos) const;
+		unsigned int GetCurrentValue() const
+		{
+			return currentValue_;
+		}
+
+	private:
+		void Relax(const BitGrid& walkable, int index, int x, int y);
+
+		std::vector<unsigned int> values_;
+		Config config_;
+		unsigned int currentValue_ = 0;
+		int width_ = 0;
+		int height_ = 0;
+	};
+} // namespace tutorial
+
+#endif // SCENT_FIELD_HPP
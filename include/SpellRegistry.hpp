@@ -49,6 +49,8 @@ namespace tutorial
 		const SpellData* Get(const std::string& id) const;
 		bool Has(const std::string& id) const;
 		std::vector<std::string> GetAllIds() const;
+		// Longest range of any loaded spell
+		float GetMaxRange() const;
 
 	private:
 		SpellRegistry() = default;
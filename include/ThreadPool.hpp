@@ -0,0 +1,59 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tutorial
+{
+	// Fixed set of worker threads for data-parallel loops. The calling
+	// thread joins in, so ParallelFor on a single-core machine simply
+	// runs inline. Calls must not be nested.
+	class ThreadPool
+	{
+	public:
+		// Shared pool sized to the hardware
+		static ThreadPool& Instance();
+
+		explicit ThreadPool(unsigned int workerCount);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Run fn(i) for every i in [0, count) and return once all have
+		// finished. Iterations may run in any order on any thread.
+		void ParallelFor(int count, const std::function<void(int)>& fn);
+
+		// Workers plus the calling thread
+		unsigned int GetConcurrency() const
+		{
+			return static_cast<unsigned int>(workers_.size()) + 1;
+		}
+
+	private:
+		void WorkerLoop();
+		void RunIterations();
+
+		std::vector<std::thread> workers_;
+
+		std::mutex submitMutex_; // One ParallelFor at a time
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable done_;
+
+		const std::function<void(int)>* job_ = nullptr;
+		std::atomic<int> next_ { 0 };
+		int count_ = 0;
+		int busyWorkers_ = 0;
+		std::uint64_t jobId_ = 0;
+		bool stopping_ = false;
+	};
+} // namespace tutorial
+
+#endif // THREAD_POOL_HPP
@@ -1,7 +1,12 @@
 #ifndef TURN_MANAGER_HPP
 #define TURN_MANAGER_HPP
 
+#include "AiComponent.hpp"
+#include "EntityHandle.hpp"
+
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace tutorial
 {
@@ -17,6 +22,18 @@ namespace tutorial
 
 	private:
 		void ProcessEnemyTurn(Engine& engine);
+
+		// Enemy turn scratch, kept between turns to save allocations
+		struct DueActor {
+			EntityHandle handle;
+			bool planAhead;
+		};
+
+		std::vector<DueActor> due_;
+		std::vector<AiIntent> intents_; // In step with due_
+		// Per slot, the enemy turn it was last planned in
+		std::vector<std::uint64_t> plannedAt_;
+		std::uint64_t turn_ = 0;
 	};
 
 } // namespace tutorial
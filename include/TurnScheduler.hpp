@@ -0,0 +1,84 @@
+#ifndef TURN_SCHEDULER_HPP
+#define TURN_SCHEDULER_HPP
+
+#include "EntityHandle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tutorial
+{
+	// Timeline of when each actor next gets to act, kept as an indexed
+	// binary heap. An actor's speed sets how far along the timeline
+	// each action pushes it, so a speed 200 actor acts twice per
+	// player turn and a speed 50 actor every other one. Actors that
+	// are not due cost nothing, and any actor can be dropped in
+	// O(log n).
+	class TurnScheduler
+	{
+	public:
+		// Speed that acts exactly once per player turn
+		static constexpr int kNormalSpeed = 100;
+		// Ticks one action takes at normal speed, and so the length
+		// of a player turn
+		static constexpr int kActionCost = 100;
+
+		void Clear();
+
+		// Schedule actor's first action one action from now,
+		// replacing any entry it already has
+		void Add(EntityHandle actor, int speed);
+		void Remove(EntityHandle actor);
+		bool Contains(EntityHandle actor) const;
+
+		// Move the clock on by ticks
+		void Advance(int ticks);
+
+		// The actor whose turn has come soonest, moved one action
+		// further along the timeline before being returned. Ties go
+		// to whichever was scheduled first. A null handle once no
+		// one is due.
+		EntityHandle NextDue();
+
+		std::uint64_t GetTime() const
+		{
+			return now_;
+		}
+
+		std::size_t size() const
+		{
+			return heap_.size();
+		}
+
+		bool empty() const
+		{
+			return heap_.empty();
+		}
+
+	private:
+		struct Entry {
+			std::uint64_t time;
+			std::uint64_t sequence;
+			EntityHandle actor;
+			int delay; // Ticks per action at the actor's speed
+		};
+
+		bool Less(std::size_t a, std::size_t b) const;
+		void Place(std::size_t index, Entry entry);
+		void SiftUp(std::size_t index);
+		void SiftDown(std::size_t index);
+		void Erase(std::size_t index);
+		// Heap index of actor, or kAbsent
+		std::uint32_t Find(EntityHandle actor) const;
+
+		static constexpr std::uint32_t kAbsent = 0xFFFFFFFF;
+
+		std::vector<Entry> heap_;
+		std::vector<std::uint32_t> positions_; // Slot -> heap index
+		std::uint64_t now_ = 0;
+		std::uint64_t nextSequence_ = 0;
+	};
+} // namespace tutorial
+
+#endif // TURN_SCHEDULER_HPP
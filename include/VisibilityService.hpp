@@ -0,0 +1,79 @@
+#ifndef VISIBILITY_SERVICE_HPP
+#define VISIBILITY_SERVICE_HPP
+
+#include "BitGrid.hpp"
+#include "EntityHandle.hpp"
+#include "Position.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tutorial
+{
+	class Map;
+
+	// Monster-perspective FOV, computed for a batch of viewers at once.
+	// Each view is a symmetric-shadowcast bitset over the viewer's
+	// (2r+1)^2 window, cached by origin tile until the terrain changes,
+	// so a viewer that did not move costs nothing the next turn.
+	// Missing views are computed in parallel on the shared ThreadPool.
+	class VisibilityService
+	{
+	public:
+		struct Viewer {
+			EntityHandle handle;
+			pos_t origin;
+		};
+
+		// Make every viewer's view current. Viewers from earlier calls
+		// that are not listed here can no longer see anything.
+		void Update(const Map& map, const std::vector<Viewer>& viewers,
+		            int radius);
+
+		// O(1); false for viewers not in the last Update
+		bool CanSee(EntityHandle viewer, pos_t tile) const;
+
+		void Clear();
+
+		// Views reused from the cache vs recomputed in the last Update
+		int GetLastCacheHits() const
+		{
+			return lastCacheHits_;
+		}
+		int GetLastComputed() const
+		{
+			return lastComputed_;
+		}
+
+	private:
+		struct View {
+			pos_t windowOrigin;
+			BitGrid bits;
+			std::uint64_t lastUsed = 0;
+		};
+
+		struct ViewerSlot {
+			std::uint32_t generation = 0;
+			const View* view = nullptr;
+		};
+
+		static constexpr std::size_t kMaxCachedViews = 1024;
+
+		std::unordered_map<int, std::unique_ptr<View>> cache_;
+		std::vector<ViewerSlot> viewers_; // By handle index
+		// Views Update has to compute, kept between calls to save
+		// allocations
+		std::vector<std::pair<pos_t, View*>> pending_;
+		const Map* map_ = nullptr;
+		unsigned int terrainVersion_ = 0;
+		int radius_ = 0;
+		std::uint64_t updateCount_ = 0;
+		int lastCacheHits_ = 0;
+		int lastComputed_ = 0;
+	};
+} // namespace tutorial
+
+#endif // VISIBILITY_SERVICE_HPP
@@ -3,69 +3,15 @@
 #include "Engine.hpp"
 #include "Entity.hpp"
 #include "Event.hpp"
+#include "FlowField.hpp"
 #include "LocaleManager.hpp"
 #include "Map.hpp"
+#include "PathFinding.hpp"
 #include "Position.hpp"
+#include "Random.hpp"
 
-#include <libtcod/bresenham.hpp>
-
-#include <array>
 #include <memory>
-#include <numeric>
-
-inline namespace
-{
-	using tutorial::pos_t;
-
-	auto check8Directions = [](pos_t pos,
-	                           pos_t target) -> tcod::BresenhamLine {
-		constexpr std::array<pos_t, 8> directions { {
-		    { 0, -1 },  // up
-		    { 0, 1 },   // down
-		    { -1, 0 },  // left
-		    { 1, 0 },   // right
-		    { -1, -1 }, // up-left
-		    { 1, -1 },  // up-right
-		    { -1, 1 },  // down-left
-		    { 1, 1 }    // down-right
-		} };
-
-		std::vector<tcod::BresenhamLine> lines;
-		lines.reserve(8);
-
-		for (auto [x, y] : directions) {
-			auto new_pos = pos_t { x, y } + target;
-
-			auto line =
-			    tcod::BresenhamLine({ pos.x, pos.y },
-			                        { new_pos.x, new_pos.y })
-			        .without_start();
-
-			lines.push_back(line);
-		}
-
-		auto shortest = lines[0];
-
-		auto bresenhamLength =
-		    [](const tcod::BresenhamLine& path) -> std::size_t {
-			std::size_t length = 0;
-
-			for (auto it = path.begin(); it != path.end(); ++it) {
-				++length;
-			}
-
-			return length;
-		};
-
-		for (auto line : lines) {
-			if (bresenhamLength(shortest) > bresenhamLength(line)) {
-				shortest = line;
-			}
-		}
-
-		return shortest;
-	};
-} // namespace
+#include <vector>
 
 namespace tutorial
 {
@@ -74,20 +20,80 @@ namespace tutorial
 		// No op
 	}
 
+	bool HostileAi::NoticesPlayer(const Engine& engine,
+	                              const Entity& entity) const
+	{
+		// Only act when this monster can see the player. With scent
+		// diffusion on, a monster standing on a fresh trail keeps
+		// hunting out of sight.
+		const auto& map = engine.GetMap();
+		bool onFreshTrail =
+		    map.GetScentField().GetConfig().diffusion
+		    && map.GetScent(entity.GetPos())
+		           > map.GetCurrentScentValue() - SCENT_THRESHOLD;
+
+		return onFreshTrail || engine.CanSeePlayer(entity);
+	}
+
+	void HostileAi::Hear(pos_t origin)
+	{
+		noise_ = origin;
+	}
+
 	void HostileAi::Perform(Engine& engine, Entity& entity)
 	{
+		Commit(engine, entity, Decide(engine, entity));
+	}
+
+	AiIntent HostileAi::Decide(const Engine& engine,
+	                           const Entity& entity) const
+	{
+		using Kind = AiIntent::Kind;
+
 		auto pos = entity.GetPos();
 
 		// Only act if entity is alive and in player's FOV
 		if (entity.GetDestructible()
 		    && entity.GetDestructible()->IsDead()) {
-			return;
+			return AiIntent { Kind::Idle };
 		}
 
-		// If not in player's FOV, don't act (monsters only act when
-		// player can see them)
-		if (!engine.GetMap().IsInFov(pos)) {
-			return;
+		const auto& map = engine.GetMap();
+		bool seesPlayer = engine.CanSeePlayer(entity);
+
+		if (!NoticesPlayer(engine, entity)) {
+			// Head for the noise around walls, and give up on it
+			// once there or when it cannot be reached. An actor in
+			// the way only holds the monster up for a turn.
+			if (noise_ && *noise_ != pos) {
+				// Noise inside the monster's own cluster is
+				// planned on the grid, anything further over
+				// the NavGraph
+				constexpr int kCluster = NavGraph::kClusterSize;
+				bool sameCluster =
+				    pos.x / kCluster == noise_->x / kCluster
+				    && pos.y / kCluster == noise_->y / kCluster;
+				auto algorithm = PathAlgorithm::Hierarchical;
+				if (sameCluster) {
+					algorithm = PathAlgorithm::JumpPoint;
+				}
+
+				// Everyone hunting the same noise walks the
+				// same cached routes until the terrain changes;
+				// only the next step is checked for blockers
+				thread_local std::vector<pos_t> route;
+				if (engine.GetPathCache().FindPath(
+				        map, pos, *noise_, route, algorithm)) {
+					if (engine.IsBlocker(route[1])) {
+						return AiIntent { Kind::Wait };
+					}
+
+					pos_t step = route[1] - pos;
+					return AiIntent { Kind::Move, step };
+				}
+			}
+
+			return AiIntent { Kind::Sleep };
 		}
 
 		auto target = engine.GetPlayer();
@@ -96,39 +102,50 @@ namespace tutorial
 
 		auto distance = std::max(std::abs(delta.x), std::abs(delta.y));
 
-		// At melee range - attack (now includes diagonal attacks)
-		if (distance == 1) {
-			std::unique_ptr<Event> event =
-			    std::make_unique<MeleeAction>(engine, entity,
-			                                  delta);
-			engine.AddEventFront(event);
-			return;
+		// At melee range - attack (now includes diagonal attacks).
+		// A monster only following the scent might be round a wall
+		// corner from the player, so it keeps to the trail instead.
+		if (distance == 1 && seesPlayer) {
+			return AiIntent { Kind::Attack, delta, true };
 		}
 
-		// Player is visible - move directly toward them
-		if (engine.GetMap().IsInFov(targetPos)) {
-			auto path = check8Directions(pos, targetPos);
+		// Player is visible - follow the shared flow field downhill.
+		// Among equally close tiles prefer the one nearest the straight
+		// line to the player, so approaches still look direct.
+		if (seesPlayer) {
+			const auto& flow = engine.GetPlayerFlowField();
+			auto bestDistance = flow.GetDistance(pos);
+			int bestSpread = 0;
+			pos_t bestStep { 0, 0 };
+
+			for (int dx = -1; dx <= 1; ++dx) {
+				for (int dy = -1; dy <= 1; ++dy) {
+					pos_t step { dx, dy };
+					pos_t cellPos = pos + step;
+					auto distance =
+					    flow.GetDistance(cellPos);
+
+					if ((dx == 0 && dy == 0)
+					    || distance > bestDistance
+					    || engine.IsBlocker(cellPos)) {
+						continue;
+					}
 
-			auto canPathToTarget =
-			    [](const tcod::BresenhamLine& path,
-			       const Engine& engine) -> bool {
-				for (const auto [x, y] : path) {
-					if (engine.IsBlocker({ x, y })) {
-						return false;
+					pos_t offset = targetPos - cellPos;
+					int spread = offset.x * offset.x
+					             + offset.y * offset.y;
+
+					if (distance < bestDistance
+					    || spread < bestSpread) {
+						bestDistance = distance;
+						bestSpread = spread;
+						bestStep = step;
 					}
 				}
-				return true;
-			};
-
-			if (canPathToTarget(path, engine)) {
-				auto dest = path[0];
-				auto destPos = pos_t { dest[0], dest[1] } - pos;
-
-				std::unique_ptr<Event> event =
-				    std::make_unique<MoveAction>(engine, entity,
-				                                 destPos);
-				engine.AddEventFront(event);
-				return;
+			}
+
+			if (bestStep != pos_t { 0, 0 }) {
+				return AiIntent { Kind::Move, bestStep, true };
 			}
 		}
 		// Player not visible - use scent tracking
@@ -147,15 +164,13 @@ namespace tutorial
 			// Only consider walkable cells
 			if (!engine.IsWall(cellPos)
 			    && !engine.IsBlocker(cellPos)) {
-				unsigned int cellScent =
-				    engine.GetMap().GetScent(cellPos);
+				unsigned int cellScent = map.GetScent(cellPos);
 
 				// Check if scent is fresh enough (not older
 				// than SCENT_THRESHOLD) and better than what
 				// we've found so far
-				if (cellScent
-				        > engine.GetMap().GetCurrentScentValue()
-				              - SCENT_THRESHOLD
+				if (cellScent > map.GetCurrentScentValue()
+				                    - SCENT_THRESHOLD
 				    && cellScent > bestLevel) {
 					bestLevel = cellScent;
 					bestCellIndex = i;
@@ -166,17 +181,58 @@ namespace tutorial
 		// If we found a cell with detectable scent, move toward it
 		if (bestCellIndex != -1) {
 			pos_t moveDir { dx[bestCellIndex], dy[bestCellIndex] };
-			std::unique_ptr<Event> event =
-			    std::make_unique<MoveAction>(engine, entity,
-			                                 moveDir);
-			engine.AddEventFront(event);
-			return;
+			return AiIntent { Kind::Move, moveDir, true };
 		}
 
 		// No valid scent trail - wait
-		std::unique_ptr<Event> event =
-		    std::make_unique<WaitAction>(engine, entity);
-		engine.AddEventFront(event);
+		return AiIntent { Kind::Wait, { 0, 0 }, true };
+	}
+
+	void HostileAi::Commit(Engine& engine, Entity& entity,
+	                       const AiIntent& intent)
+	{
+		using Kind = AiIntent::Kind;
+
+		// Actors committed earlier this turn may have taken the tile
+		// since the plan was made. Plan again against the board as
+		// it is now; if that also wants an occupied tile, wait.
+		AiIntent plan = intent;
+		if (plan.kind == Kind::Move
+		    && engine.IsBlocker(entity.GetPos() + plan.step)) {
+			plan = Decide(engine, entity);
+			if (plan.kind == Kind::Move
+			    && engine.IsBlocker(entity.GetPos() + plan.step)) {
+				plan.kind = Kind::Wait;
+			}
+		}
+
+		if (plan.noticedPlayer) {
+			noise_.reset();
+		}
+
+		switch (plan.kind) {
+			case Kind::Wait:
+				engine.AddEventFront(
+				    WaitAction(engine, entity));
+				break;
+			case Kind::Move:
+				engine.AddEventFront(
+				    MoveAction(engine, entity, plan.step));
+				break;
+			case Kind::Attack:
+				engine.AddEventFront(
+				    MeleeAction(engine, entity, plan.step));
+				break;
+			case Kind::Sleep:
+				noise_.reset();
+				engine.PutToSleep(entity);
+				break;
+			case Kind::Perform:
+				Perform(engine, entity);
+				break;
+			case Kind::Idle:
+				break;
+		}
 	}
 
 	ConfusedMonsterAi::ConfusedMonsterAi(int nbTurns,
@@ -188,9 +244,9 @@ namespace tutorial
 	void ConfusedMonsterAi::Perform(Engine& engine, Entity& entity)
 	{
 		// Wander randomly
-		auto* rand = TCODRandom::getInstance();
-		int dx = rand->getInt(-1, 1);
-		int dy = rand->getInt(-1, 1);
+		auto& rand = GetRandom(RandomStream::Ai);
+		int dx = rand.GetInt(-1, 1);
+		int dy = rand.GetInt(-1, 1);
 
 		if (dx != 0 || dy != 0) {
 			int destx = entity.GetPos().x + dx;
@@ -203,17 +259,11 @@ namespace tutorial
 				if (target) {
 					// Attack anyone including other
 					// monsters
-					std::unique_ptr<Event> event =
-					    std::make_unique<MeleeAction>(
-					        engine, entity,
-					        pos_t { dx, dy });
-					engine.AddEventFront(event);
+					engine.AddEventFront(MeleeAction(
+					    engine, entity, pos_t { dx, dy }));
 				} else {
-					std::unique_ptr<Event> event =
-					    std::make_unique<MoveAction>(
-					        engine, entity,
-					        pos_t { dx, dy });
-					engine.AddEventFront(event);
+					engine.AddEventFront(MoveAction(
+					    engine, entity, pos_t { dx, dy }));
 				}
 			}
 		}
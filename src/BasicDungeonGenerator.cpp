@@ -1,12 +1,11 @@
 #include "BasicDungeonGenerator.hpp"
 
+#include "ConnectivityAnalyzer.hpp"
 #include "MapGenerator.hpp"
-#include "PathFinding.hpp"
+#include "Random.hpp"
 #include "Room.hpp"
 #include "Tile.hpp"
 
-#include <libtcod.h>
-
 #include <algorithm>
 
 namespace tutorial
@@ -16,10 +15,10 @@ namespace tutorial
 		// Pick a random position within bounds, with margin from edges
 		pos_t PickRandomPosition(int width, int height, int margin)
 		{
-			auto* rand = TCODRandom::getInstance();
-			return pos_t { rand->getInt(margin, width - margin - 1),
-				       rand->getInt(margin,
-				                    height - margin - 1) };
+			auto& rand = GetRandom(RandomStream::Generation);
+			return pos_t { rand.GetInt(margin, width - margin - 1),
+				       rand.GetInt(margin,
+				                   height - margin - 1) };
 		}
 
 		// Check if a room would overlap with existing rooms
@@ -70,12 +69,13 @@ namespace tutorial
 		// Phase 1: Generate winding trails
 		GenerateTrails(map);
 
-		// Phase 2: Connect all trail endpoints
-		ConnectTrails(map);
-
-		// Phase 3: Place rooms over the structure
+		// Phase 2: Place rooms over the structure
 		PlaceRooms(map);
 
+		// Phase 3: Carve the cheapest corridors joining whatever trails
+		// and rooms are still apart
+		ConnectivityAnalyzer().Connect(map);
+
 		// Note: Door placement will come in Phase 4
 	}
 
@@ -99,58 +99,27 @@ namespace tutorial
 		}
 	}
 
-	void BasicDungeonGenerator::ConnectTrails(Map& map)
-	{
-		// Collect all trail endpoints (both start and end of each
-		// trail)
-		std::vector<pos_t> endpoints;
-		for (const auto& trail : trails_) {
-			endpoints.push_back(trail.start);
-			endpoints.push_back(trail.end);
-		}
-
-		// Connect each endpoint to every other endpoint
-		// This ensures full connectivity (DCSS does this)
-		for (size_t i = 0; i < endpoints.size(); ++i) {
-			for (size_t j = i + 1; j < endpoints.size(); ++j) {
-				// Find path between endpoints
-				std::vector<pos_t> path =
-				    FindPath(map, endpoints[i], endpoints[j]);
-
-				// Carve the path (it should already be mostly
-				// floor, but ensures connectivity)
-				for (const auto& pos : path) {
-					if (map.IsWall(pos)) {
-						map.SetTileType(
-						    pos, TileType::FLOOR);
-					}
-				}
-			}
-		}
-	}
-
 	void BasicDungeonGenerator::PlaceRooms(Map& map)
 	{
-		auto* rand = TCODRandom::getInstance();
+		auto& rand = GetRandom(RandomStream::Generation);
 
 		// Decide how many rooms to place
-		int numRooms = rand->getInt(config_.minRooms, config_.maxRooms);
+		int numRooms = rand.GetInt(config_.minRooms, config_.maxRooms);
 
 		std::vector<Room> placedRooms;
 
 		// Try to place rooms
 		for (int attempt = 0; attempt < numRooms * 10; ++attempt) {
 			// Random room size
-			int roomWidth = rand->getInt(config_.minRoomSize,
+			int roomWidth = rand.GetInt(config_.minRoomSize,
+			                            config_.maxRoomSize);
+			int roomHeight = rand.GetInt(config_.minRoomSize,
 			                             config_.maxRoomSize);
-			int roomHeight = rand->getInt(config_.minRoomSize,
-			                              config_.maxRoomSize);
 
 			// Random position (with 1-tile margin from edges)
 			pos_t roomOrigin {
-				rand->getInt(1, map.GetWidth() - roomWidth - 2),
-				rand->getInt(1,
-				             map.GetHeight() - roomHeight - 2)
+				rand.GetInt(1, map.GetWidth() - roomWidth - 2),
+				rand.GetInt(1, map.GetHeight() - roomHeight - 2)
 			};
 
 			Room newRoom(roomOrigin, roomWidth, roomHeight);
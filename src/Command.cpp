@@ -122,9 +122,8 @@ namespace tutorial
 		}
 
 		consumesTurn_ = true;
-		std::unique_ptr<Event> action = std::make_unique<BumpAction>(
-		    engine, *engine.GetPlayer(), pos_t { dx_, dy_ });
-		engine.AddEventFront(action);
+		engine.AddEventFront(BumpAction(engine, *engine.GetPlayer(),
+		                                pos_t { dx_, dy_ }));
 	}
 
 	bool MoveCommand::ConsumesTurn()
@@ -134,16 +133,12 @@ namespace tutorial
 
 	void WaitCommand::Execute(Engine& engine)
 	{
-		std::unique_ptr<Event> action =
-		    std::make_unique<WaitAction>(engine, *engine.GetPlayer());
-		engine.AddEventFront(action);
+		engine.AddEventFront(WaitAction(engine, *engine.GetPlayer()));
 	}
 
 	void PickupCommand::Execute(Engine& engine)
 	{
-		std::unique_ptr<Event> action =
-		    std::make_unique<PickupAction>(engine, *engine.GetPlayer());
-		engine.AddEventFront(action);
+		engine.AddEventFront(PickupAction(engine, *engine.GetPlayer()));
 	}
 
 	void DescendStairsCommand::Execute(Engine& engine)
@@ -168,10 +163,8 @@ namespace tutorial
 
 	void PickupItemCommand::Execute(Engine& engine)
 	{
-		std::unique_ptr<Event> action =
-		    std::make_unique<PickupItemAction>(
-		        engine, *engine.GetPlayer(), item_);
-		engine.AddEventFront(action);
+		engine.AddEventFront(
+		    PickupItemAction(engine, *engine.GetPlayer(), item_));
 	}
 
 	// Helper function to handle stack decrement/removal
@@ -260,10 +253,7 @@ namespace tutorial
 		}
 
 		// Create and execute CastSpellAction
-		std::unique_ptr<Event> action =
-		    std::make_unique<CastSpellAction>(engine, *player,
-		                                      spellId_);
-		action->Execute();
+		CastSpellAction(engine, *player, spellId_).Execute();
 
 		// Check if spell was actually cast (MP was spent)
 		// If CastSpellAction successfully executed, it spent MP
@@ -278,10 +268,8 @@ namespace tutorial
 
 	void DropItemCommand::Execute(Engine& engine)
 	{
-		std::unique_ptr<Event> action =
-		    std::make_unique<DropItemAction>(
-		        engine, *engine.GetPlayer(), itemIndex_);
-		engine.AddEventFront(action);
+		engine.AddEventFront(
+		    DropItemAction(engine, *engine.GetPlayer(), itemIndex_));
 	}
 
 } // namespace tutorial
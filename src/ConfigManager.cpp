@@ -6,6 +6,28 @@
 
 namespace tutorial
 {
+	inline namespace
+	{
+		FovAlgorithm ParseFovAlgorithm(const nlohmann::json& player)
+		{
+			std::string name =
+			    player.value("fov_algorithm", "restrictive");
+
+			if (name == "shadowcast") {
+				return FovAlgorithm::Shadowcast;
+			}
+
+			if (name != "restrictive") {
+				std::cerr << "[ConfigManager] Unknown "
+				             "fov_algorithm '"
+				          << name << "', using restrictive"
+				          << std::endl;
+			}
+
+			return FovAlgorithm::Restrictive;
+		}
+	} // namespace
+
 	ConfigManager& ConfigManager::Instance()
 	{
 		static ConfigManager instance;
@@ -36,6 +58,7 @@ namespace tutorial
 	{
 		gameConfig_.clear();
 		uiConfig_.clear();
+		fovAlgorithm_ = FovAlgorithm::Restrictive;
 	}
 
 	void ConfigManager::LoadGameConfig()
@@ -62,6 +85,10 @@ namespace tutorial
 			throw std::runtime_error(
 			    "game.json missing required 'player' section");
 		}
+
+		// Read on every monster's sight check, often from worker
+		// threads, so parse it once here
+		fovAlgorithm_ = ParseFovAlgorithm(gameConfig_["player"]);
 	}
 
 	void ConfigManager::LoadUIConfig()
@@ -102,6 +129,11 @@ namespace tutorial
 		return gameConfig_["player"]["fov_radius"].get<int>();
 	}
 
+	FovAlgorithm ConfigManager::GetPlayerFOVAlgorithm() const
+	{
+		return fovAlgorithm_;
+	}
+
 	int ConfigManager::GetMaxInventorySize() const
 	{
 		if (!gameConfig_.contains("player")
@@ -121,6 +153,20 @@ namespace tutorial
 		                                       1.0f);
 	}
 
+	ScentField::Config ConfigManager::GetScentConfig() const
+	{
+		ScentField::Config config;
+		if (!gameConfig_.contains("scent")) {
+			return config; // Defaults
+		}
+
+		const auto& scent = gameConfig_["scent"];
+		config.diffusion = scent.value("diffusion", config.diffusion);
+		config.diffusionRange =
+		    scent.value("diffusion_range", config.diffusionRange);
+		return config;
+	}
+
 	bool ConfigManager::IsDebugShowAllMap() const
 	{
 		if (!gameConfig_.contains("debug")) {
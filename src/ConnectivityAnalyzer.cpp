@@ -0,0 +1,242 @@
+#include "ConnectivityAnalyzer.hpp"
+
+#include "Map.hpp"
+#include "Tile.hpp"
+#include "Util.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace tutorial
+{
+	inline namespace
+	{
+		int FindRoot(std::vector<int>& parent, int i)
+		{
+			while (parent[i] != i) {
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+			}
+
+			return i;
+		}
+
+		// The lower index always becomes the root, so a root precedes
+		// every other member of its set
+		void Unite(std::vector<int>& parent, int a, int b)
+		{
+			a = FindRoot(parent, a);
+			b = FindRoot(parent, b);
+			if (a != b) {
+				parent[std::max(a, b)] = std::min(a, b);
+			}
+		}
+
+		// Two touching tiles grown from different components; cost is
+		// the walls between them
+		struct Bridge {
+			int cost;
+			int a;
+			int b;
+		};
+	} // namespace
+
+	void ConnectivityAnalyzer::Analyze(const BitGrid& walkable, int width,
+	                                   int height)
+	{
+		width_ = width;
+		height_ = height;
+		labels_.assign(width * height, -1);
+		sizes_.clear();
+
+		// The scan has already seen the west and north neighbours
+		std::vector<int> parent(width * height, -1);
+		walkable.ForEachSet([&](int index) {
+			parent[index] = index;
+			if (index % width > 0 && walkable.Get(index - 1)) {
+				Unite(parent, index, index - 1);
+			}
+			if (index >= width && walkable.Get(index - width)) {
+				Unite(parent, index, index - width);
+			}
+		});
+
+		// Roots come first, so their ids are known by the time the
+		// rest of the component is reached
+		walkable.ForEachSet([&](int index) {
+			int root = FindRoot(parent, index);
+			if (root == index) {
+				labels_[index] =
+				    static_cast<int>(sizes_.size());
+				sizes_.push_back(0);
+			} else {
+				labels_[index] = labels_[root];
+			}
+			++sizes_[labels_[index]];
+		});
+	}
+
+	int ConnectivityAnalyzer::GetComponent(pos_t pos) const
+	{
+		if (pos.x < 0 || pos.y < 0 || pos.x >= width_
+		    || pos.y >= height_) {
+			return -1;
+		}
+
+		return labels_[util::posToIndex(pos, width_)];
+	}
+
+	std::vector<ConnectivityAnalyzer::Cut> ConnectivityAnalyzer::FindCuts()
+	    const
+	{
+		std::vector<Cut> cuts;
+		if (IsConnected()) {
+			return cuts;
+		}
+
+		// Breadth-first from every floor tile at once. Each wall is
+		// claimed by the nearest component; where two claims meet,
+		// the walls back to both sources are a candidate cut.
+		int size = width_ * height_;
+		std::vector<int> owner(labels_);
+		std::vector<int> depth(size, 0);
+		std::vector<int> from(size, -1);
+		std::vector<int> queue;
+		queue.reserve(size);
+		for (int i = 0; i < size; ++i) {
+			if (owner[i] >= 0) {
+				queue.push_back(i);
+			}
+		}
+
+		auto interior = [this](int index) {
+			pos_t pos = util::indexToPos(index, width_);
+			return pos.x > 0 && pos.y > 0 && pos.x < width_ - 1
+			       && pos.y < height_ - 1;
+		};
+
+		// Cheapest meeting per pair of components
+		std::unordered_map<std::uint64_t, Bridge> bridges;
+
+		for (std::size_t head = 0; head < queue.size(); ++head) {
+			int current = queue[head];
+			pos_t pos = util::indexToPos(current, width_);
+			int neighbours[] = {
+				pos.x > 0 ? current - 1 : -1,
+				pos.x < width_ - 1 ? current + 1 : -1,
+				pos.y > 0 ? current - width_ : -1,
+				pos.y < height_ - 1 ? current + width_ : -1
+			};
+
+			for (int next : neighbours) {
+				if (next < 0) {
+					continue;
+				}
+
+				if (owner[next] < 0) {
+					if (!interior(next)) {
+						continue;
+					}
+					owner[next] = owner[current];
+					depth[next] = depth[current] + 1;
+					from[next] = current;
+					queue.push_back(next);
+					continue;
+				}
+
+				int a = owner[current];
+				int b = owner[next];
+				if (a == b) {
+					continue;
+				}
+
+				Bridge bridge { depth[current] + depth[next],
+					        current, next };
+				if (a > b) {
+					std::swap(a, b);
+					std::swap(bridge.a, bridge.b);
+				}
+
+				std::uint64_t key =
+				    (static_cast<std::uint64_t>(a) << 32) | b;
+				auto [it, inserted] =
+				    bridges.emplace(key, bridge);
+				if (!inserted
+				    && bridge.cost < it->second.cost) {
+					it->second = bridge;
+				}
+			}
+		}
+
+		// Kruskal over the candidates. Ties fall back to tile order so
+		// the result does not depend on hash iteration.
+		std::vector<Bridge> sorted;
+		sorted.reserve(bridges.size());
+		for (const auto& entry : bridges) {
+			sorted.push_back(entry.second);
+		}
+		std::sort(sorted.begin(), sorted.end(),
+		          [](const Bridge& lhs, const Bridge& rhs) {
+			          return std::tie(lhs.cost, lhs.a, lhs.b)
+			                 < std::tie(rhs.cost, rhs.a, rhs.b);
+		          });
+
+		std::vector<int> joined(sizes_.size());
+		std::iota(joined.begin(), joined.end(), 0);
+
+		for (const auto& bridge : sorted) {
+			int a = owner[bridge.a];
+			int b = owner[bridge.b];
+			if (FindRoot(joined, a) == FindRoot(joined, b)) {
+				continue;
+			}
+			Unite(joined, a, b);
+
+			// Walls in order from component a to component b
+			Cut cut { a, b, {} };
+			for (int i = bridge.a; depth[i] > 0; i = from[i]) {
+				cut.walls.push_back(
+				    util::indexToPos(i, width_));
+			}
+			std::reverse(cut.walls.begin(), cut.walls.end());
+			for (int i = bridge.b; depth[i] > 0; i = from[i]) {
+				cut.walls.push_back(
+				    util::indexToPos(i, width_));
+			}
+			cuts.push_back(std::move(cut));
+
+			if (cuts.size() + 1 == sizes_.size()) {
+				break;
+			}
+		}
+
+		return cuts;
+	}
+
+	int ConnectivityAnalyzer::Connect(Map& map)
+	{
+		const BitGrid& walkable = map.GetWalkablePlane();
+		Analyze(walkable, map.GetWidth(), map.GetHeight());
+
+		int carved = 0;
+		for (const auto& cut : FindCuts()) {
+			// Cuts from one component may share walls
+			for (auto pos : cut.walls) {
+				if (map.IsWall(pos)) {
+					map.SetTileType(pos, TileType::FLOOR);
+					++carved;
+				}
+			}
+		}
+
+		if (carved > 0) {
+			Analyze(walkable, map.GetWidth(), map.GetHeight());
+		}
+
+		return carved;
+	}
+} // namespace tutorial
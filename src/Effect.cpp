@@ -94,6 +94,9 @@ namespace tutorial
 			auto confusedAi = std::make_unique<ConfusedMonsterAi>(
 			    duration_, npc->SwapAi(nullptr));
 			npc->SwapAi(std::move(confusedAi));
+
+			// Confusion runs its course even with no one in view
+			engine.WakeActor(*npc);
 			return true;
 		}
 
@@ -1,6 +1,5 @@
 #include "Engine.hpp"
 
-#include "BasicDungeonGenerator.hpp"
 #include "CharacterCreationWindow.hpp"
 #include "Colors.hpp"
 #include "DynamicSpawnSystem.hpp"
@@ -13,18 +12,20 @@
 #include "LevelConfig.hpp"
 #include "LocaleManager.hpp"
 #include "Map.hpp"
-#include "MapGenerator.hpp"
 #include "MenuWindow.hpp"
 #include "MessageHistoryWindow.hpp"
 #include "MessageLogWindow.hpp"
 #include "PathFinding.hpp"
+#include "Random.hpp"
 #include "SaveManager.hpp"
 #include "SpellMenuWindow.hpp"
 #include "SpellRegistry.hpp"
 #include "SpellcasterComponent.hpp"
 
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <stdexcept>
 #include <string>
 
@@ -38,9 +39,9 @@ namespace tutorial
 	      messageHistoryWindow_(std::make_unique<MessageHistoryWindow>(
 	          config.width, config.height, pos_t { 0, 0 }, messageLog_)),
 	      messageLogWindow_(nullptr),
-	      player_(nullptr),
+	      player_(),
 	      healthBar_(nullptr),
-	      stairs_(nullptr),
+	      stairs_(),
 	      dungeonLevel_(1),
 	      turnsSinceLastAutosave_(0),
 	      context_(nullptr),
@@ -136,18 +137,164 @@ namespace tutorial
 		SDL_Quit();
 	}
 
-	void Engine::AddEventFront(Event_ptr& event)
+	void Engine::AddEventFront(ActionRecord action)
 	{
-		eventQueue_.push_front(std::move(event));
+		eventQueue_.PushFront(std::move(action));
+	}
+
+	void Engine::UpdatePlayerFlowField()
+	{
+		if (Entity* player = GetPlayer()) {
+			playerFlowField_.Update(*map_, player->GetPos());
+		}
+	}
+
+	void Engine::UpdateMonsterVisibility()
+	{
+		auto& cfg = ConfigManager::Instance();
+		Entity* player = GetPlayer();
+
+		// Symmetric FOV: the player seeing a monster is the same as
+		// the monster seeing the player, so no views are needed
+		if (!player
+		    || cfg.GetPlayerFOVAlgorithm()
+		           == FovAlgorithm::Shadowcast) {
+			return;
+		}
+
+		int radius = cfg.GetPlayerFOVRadius();
+		pos_t playerPos = player->GetPos();
+
+		auto addViewer = [&](Entity* entity) {
+			if (entity != player && entity->CanAct()) {
+				viewers_.push_back(
+				    { entity->GetHandle(), entity->GetPos() });
+			}
+		};
+
+		viewers_.clear();
+		if (radius > 0) {
+			// Out of sight range of the player can never see them
+			pos_t extent { radius, radius };
+			nearbyActors_.clear();
+			entities_.QueryRect(playerPos - extent,
+			                    playerPos + extent, nearbyActors_);
+			for (auto* entity : nearbyActors_) {
+				addViewer(entity);
+			}
+		} else {
+			for (auto* entity : entities_) {
+				addViewer(entity);
+			}
+		}
+
+		monsterVisibility_.Update(*map_, viewers_, radius);
+	}
+
+	bool Engine::CanSeePlayer(const Entity& entity) const
+	{
+		Entity* player = GetPlayer();
+		if (!player) {
+			return false;
+		}
+
+		if (ConfigManager::Instance().GetPlayerFOVAlgorithm()
+		    == FovAlgorithm::Shadowcast) {
+			return map_->IsInFov(entity.GetPos());
+		}
+
+		return monsterVisibility_.CanSee(entity.GetHandle(),
+		                                 player->GetPos());
+	}
+
+	bool Engine::IsAwake(const Entity& entity) const
+	{
+		return entities_.GetScheduler().Contains(entity.GetHandle());
+	}
+
+	void Engine::WakeActor(Entity& entity)
+	{
+		EntityHandle handle = entity.GetHandle();
+		if (!entities_.GetComponents().ai.Has(handle.index)
+		    || !entity.CanAct()) {
+			return;
+		}
+
+		auto& scheduler = entities_.GetScheduler();
+		if (!scheduler.Contains(handle)) {
+			scheduler.Add(handle, entity.GetSpeed());
+		}
+	}
+
+	void Engine::PutToSleep(Entity& entity)
+	{
+		entities_.GetScheduler().Remove(entity.GetHandle());
+	}
+
+	void Engine::MakeNoise(pos_t origin, float radius)
+	{
+		nearbyActors_.clear();
+		entities_.QueryRadius(origin, radius, nearbyActors_);
+
+		auto& ai = entities_.GetComponents().ai;
+		for (auto* entity : nearbyActors_) {
+			auto* slot = ai.Get(entity->GetHandle().index);
+			if (slot && *slot && entity->CanAct()) {
+				(*slot)->Hear(origin);
+				WakeActor(*entity);
+			}
+		}
+	}
+
+	void Engine::WakeNearbyActors()
+	{
+		Entity* player = GetPlayer();
+		if (!player) {
+			return;
+		}
+
+		// Only actors in sight range can see the player, and scent
+		// leaks out of sight by at most the diffusion range
+		int radius = ConfigManager::Instance().GetPlayerFOVRadius();
+		const auto& scent = map_->GetScentField().GetConfig();
+
+		nearbyActors_.clear();
+		if (radius > 0) {
+			int reach = radius
+			            + (scent.diffusion ? scent.diffusionRange
+			                               : 0);
+			pos_t extent { reach, reach };
+			entities_.QueryRect(player->GetPos() - extent,
+			                    player->GetPos() + extent,
+			                    nearbyActors_);
+		} else {
+			nearbyActors_.assign(entities_.begin(),
+			                     entities_.end());
+		}
+
+		auto& ai = entities_.GetComponents().ai;
+		for (auto* entity : nearbyActors_) {
+			auto* slot = ai.Get(entity->GetHandle().index);
+			if (!slot || !*slot || IsAwake(*entity)
+			    || !entity->CanAct()) {
+				continue;
+			}
+
+			if ((*slot)->NoticesPlayer(*this, *entity)) {
+				WakeActor(*entity);
+			}
+		}
 	}
 
 	void Engine::ComputeFOV()
 	{
-		int fovRadius = ConfigManager::Instance().GetPlayerFOVRadius();
-		map_->ComputeFov(player_->GetPos(), fovRadius);
-		map_->UpdateScent(
-		    player_
-		        ->GetPos()); // Update scent field after FOV computation
+		auto& cfg = ConfigManager::Instance();
+		Entity* player = GetPlayer();
+		map_->ComputeFov(player->GetPos(), cfg.GetPlayerFOVRadius(),
+		                 cfg.GetPlayerFOVAlgorithm());
+		// Update scent field after FOV computation
+		map_->UpdateScent(player->GetPos());
+
 		map_->Update();
 	}
 
@@ -160,13 +307,14 @@ namespace tutorial
 	{
 		// For both player and non-player: mark for deferred removal
 		// This ensures corpse spawning happens consistently
-		entitiesToRemove_.push_back(&entity);
+		entitiesToRemove_.push_back(entity.GetHandle());
+		entities_.GetScheduler().Remove(entity.GetHandle());
 
 		// Player-specific handling
 		if (this->IsPlayer(entity)) {
 			eventHandler_ =
 			    std::make_unique<GameOverEventHandler>(*this);
-			eventQueue_.clear();
+			eventQueue_.Clear();
 			gameOver_ = true;
 		}
 	}
@@ -174,32 +322,36 @@ namespace tutorial
 	void Engine::HandleEvents()
 	{
 		// Remember player position before events
+		Entity* player = GetPlayer();
 		pos_t playerPosBefore =
-		    player_ ? player_->GetPos() : pos_t { 0, 0 };
+		    player ? player->GetPos() : pos_t { 0, 0 };
 
 		while (!eventQueue_.empty()) {
-			auto event = std::move(eventQueue_.front());
-			eventQueue_.pop_front();
-			event->Execute();
+			ActionRecord action = eventQueue_.PopFront();
+			Execute(action);
 		}
 
 		// Post-processing: Update FOV if player moved
-		if (player_) {
-			pos_t playerPosAfter = player_->GetPos();
+		player = GetPlayer();
+		if (player) {
+			pos_t playerPosAfter = player->GetPos();
 			if (playerPosBefore != playerPosAfter) {
 				ComputeFOV();
 			}
 		}
 
-		eventQueue_.clear();
+		eventQueue_.Clear();
 
 		// Regenerate MP for all entities with spellcaster component
-		for (auto& entity : entities_) {
-			if (entity->GetSpellcaster()
-			    && entity->GetDestructible()) {
-				entity->GetDestructible()->RegenerateMp(1);
-			}
-		}
+		auto& components = entities_.GetComponents();
+		components.spellcasters.ForEach(
+		    [&](EntityId id, SpellcasterComponent&) {
+			    auto* destructible =
+			        components.destructibles.Get(id);
+			    if (destructible) {
+				    destructible->RegenerateMp(1);
+			    }
+		    });
 
 		ProcessDeferredRemovals();
 	}
@@ -222,6 +374,8 @@ namespace tutorial
 			// console size UI elements render in the extra console
 			// space (columns 80-99)
 			map_ = std::make_unique<Map>(80, 45);
+			map_->SetScentConfig(cfg.GetScentConfig());
+			entities_.Resize(map_->GetWidth(), map_->GetHeight());
 		}
 
 		// Initialize message log window if not already created
@@ -245,6 +399,13 @@ namespace tutorial
 		// Ensure basic components are initialized
 		EnsureInitialized();
 
+		// A pending build reads the templates reloaded below
+		levelPrefetcher_.Cancel();
+
+		// Fresh master seed per game; the save keeps it
+		RandomService::Instance().Seed(std::random_device {}());
+		dungeonLevel_ = 1;
+
 		currentLevel_ =
 		    LevelConfig::LoadFromFile("data/levels/dungeon_1.json");
 
@@ -269,6 +430,11 @@ namespace tutorial
 			SpellRegistry::Instance().LoadFromDirectory(
 			    "data/spells");
 
+			// Rays for every tile a spell can reach; item ranges
+			// beyond this grow the table on first use
+			lineOfSight_.Reserve(static_cast<int>(std::ceil(
+			    SpellRegistry::Instance().GetMaxRange())));
+
 			std::cout
 			    << "[Engine] Loaded "
 			    << TemplateRegistry::Instance().GetAllIds().size()
@@ -294,23 +460,16 @@ namespace tutorial
 
 		entities_.Clear();
 		messageLog_.Clear();
-		eventQueue_.clear();
+		eventQueue_.Clear();
 
-		this->GenerateMap(currentLevel_.generation.width,
-		                  currentLevel_.generation.height);
+		ScopedLevelRandom levelRandom(
+		    RandomService::Instance().GetMasterSeed(), dungeonLevel_);
+		this->GenerateMap();
 
 		auto rooms = map_->GetRooms();
 
-		for (auto it = rooms.begin() + 1; it != rooms.end(); ++it) {
-			entities_.PlaceItems(*it, currentLevel_.itemSpawning,
-			                     currentLevel_.id);
-		}
-
-		for (auto it = rooms.begin() + 1; it != rooms.end(); ++it) {
-			entities_.PlaceEntities(*it,
-			                        currentLevel_.monsterSpawning,
-			                        currentLevel_.id);
-		}
+		entities_.PopulateRooms(rooms.begin() + 1, rooms.end(),
+		                        currentLevel_);
 
 		// Find first room that's on floor (connected to trails)
 		pos_t playerSpawn = rooms[0].GetCenter();
@@ -324,11 +483,12 @@ namespace tutorial
 
 		auto playerEntity =
 		    TemplateRegistry::Instance().Create("player", playerSpawn);
-		player_ = entities_.Spawn(std::move(playerEntity)).get();
+		Entity* player = entities_.Spawn(std::move(playerEntity));
+		player_ = player->GetHandle();
 
 		// Give player starting spells and MP
-		if (player_) {
-			auto* destructible = player_->GetDestructible();
+		if (player) {
+			auto* destructible = player->GetDestructible();
 			if (destructible) {
 				// Set player's intelligence to 20 for testing
 				// (gives 20 MP)
@@ -346,7 +506,7 @@ namespace tutorial
 
 			// Attach to player using SetSpellcaster
 			if (auto* basePlayer =
-			        dynamic_cast<BaseEntity*>(player_)) {
+			        dynamic_cast<BaseEntity*>(player)) {
 				basePlayer->SetSpellcaster(
 				    std::move(spellcaster));
 			}
@@ -356,7 +516,7 @@ namespace tutorial
 		healthBar_ = std::make_unique<HealthBar>(
 		    cfg.GetHealthBarWidth(), cfg.GetHealthBarHeight(),
 		    pos_t { cfg.GetHealthBarX(), cfg.GetHealthBarY() },
-		    *player_);
+		    *player);
 
 		// Place stairs in the center of the last room (furthest from
 		// player)
@@ -364,8 +524,8 @@ namespace tutorial
 			pos_t stairsPos = rooms.back().GetCenter();
 			auto stairsEntity = TemplateRegistry::Instance().Create(
 			    "stairs_down", stairsPos);
-			stairs_ =
-			    entities_.Spawn(std::move(stairsEntity)).get();
+			stairs_ = entities_.Spawn(std::move(stairsEntity))
+				      ->GetHandle();
 			std::cout << "[Engine] Placed stairs at ("
 			          << stairsPos.x << ", " << stairsPos.y << ")"
 			          << std::endl;
@@ -377,7 +537,7 @@ namespace tutorial
 		    invWidth, invHeight, cfg.GetInventoryCenterOnScreen());
 
 		inventoryWindow_ = std::make_unique<InventoryWindow>(
-		    invWidth, invHeight, invPos, *player_);
+		    invWidth, invHeight, invPos, *player);
 
 		this->ComputeFOV();
 
@@ -390,6 +550,8 @@ namespace tutorial
 		eventHandler_ = std::make_unique<MainGameEventHandler>(*this);
 		gameOver_ = false;
 		turnsSinceLastAutosave_ = 0;
+
+		PrefetchNextLevel();
 	}
 
 	void Engine::ReturnToMainGame()
@@ -450,14 +612,17 @@ namespace tutorial
 			    width, height, cfg.GetInventoryCenterOnScreen());
 
 			spellMenuWindow_ = std::make_unique<SpellMenuWindow>(
-			    width, height, pos, *player_);
+			    width, height, pos, *GetPlayer());
 		}
 	}
 
 	void Engine::ShowItemSelection(const std::vector<Entity*>& items)
 	{
 		if (windowState_ != ItemSelection) {
-			itemSelectionList_ = items;
+			itemSelectionList_.clear();
+			for (auto* item : items) {
+				itemSelectionList_.push_back(item->GetHandle());
+			}
 
 			auto& cfg = ConfigManager::Instance();
 			int width = cfg.GetInventoryWindowWidth();
@@ -467,7 +632,8 @@ namespace tutorial
 
 			itemSelectionWindow_ =
 			    std::make_unique<ItemSelectionWindow>(
-			        width, height, pos, itemSelectionList_,
+			        width, height, pos, entities_,
+			        itemSelectionList_,
 			        "Pick up which item?");
 
 			eventHandler_ =
@@ -766,13 +932,14 @@ namespace tutorial
 
 	void Engine::HandleLevelUpConfirm(MenuAction action)
 	{
-		if (!player_ || !player_->GetDestructible()) {
+		Entity* player = GetPlayer();
+		if (!player || !player->GetDestructible()) {
 			ReturnToMainGame();
 			return;
 		}
 
-		auto* destructible = player_->GetDestructible();
-		auto* attacker = player_->GetAttacker();
+		auto* destructible = player->GetDestructible();
+		auto* attacker = player->GetAttacker();
 
 		// Every level up grants +4 HP
 		destructible->IncreaseMaxHealth(4);
@@ -901,11 +1068,12 @@ namespace tutorial
 
 	void Engine::GrantXpToPlayer(unsigned int xpAmount)
 	{
-		if (!player_ || !player_->GetDestructible()) {
+		Entity* player = GetPlayer();
+		if (!player || !player->GetDestructible()) {
 			return;
 		}
 
-		auto* destructible = player_->GetDestructible();
+		auto* destructible = player->GetDestructible();
 		unsigned int oldXp = destructible->GetXp();
 
 		destructible->AddXp(xpAmount);
@@ -936,15 +1104,20 @@ namespace tutorial
 		mousePos_ = pos;
 	}
 
-	std::unique_ptr<Entity> Engine::RemoveEntity(Entity* entity)
+	std::unique_ptr<Entity> Engine::RemoveEntity(EntityHandle handle)
 	{
-		return entities_.Remove(entity);
+		return entities_.Remove(handle);
 	}
 
 	Entity* Engine::SpawnEntity(std::unique_ptr<Entity> entity, pos_t pos)
 	{
 		entity->SetPos(pos);
-		return entities_.Spawn(std::move(entity), pos).get();
+		return entities_.Spawn(std::move(entity), pos);
+	}
+
+	void Engine::MoveEntity(Entity& entity, pos_t pos)
+	{
+		entities_.SetPos(entity, pos);
 	}
 
 	Entity* Engine::GetBlockingEntity(pos_t pos) const
@@ -954,7 +1127,12 @@ namespace tutorial
 
 	Entity* Engine::GetPlayer() const
 	{
-		return player_;
+		return entities_.Get(player_);
+	}
+
+	Entity* Engine::GetEntity(EntityHandle handle) const
+	{
+		return entities_.Get(handle);
 	}
 
 	pos_t Engine::GetMousePos() const
@@ -1012,7 +1190,7 @@ namespace tutorial
 
 	bool Engine::IsPlayer(const Entity& entity) const
 	{
-		return player_ == &entity;
+		return GetPlayer() == &entity;
 	}
 
 	bool Engine::IsRunning() const
@@ -1020,14 +1198,9 @@ namespace tutorial
 		return running_ && window_ != nullptr;
 	}
 
-	bool Engine::IsValid(Entity& entity) const
+	bool Engine::IsValid(EntityHandle handle) const
 	{
-		auto it = std::find_if(entities_.begin(), entities_.end(),
-		                       [&entity](const auto& it) {
-			                       return (it.get() == &entity);
-		                       });
-
-		return (it != entities_.end());
+		return entities_.IsValid(handle);
 	}
 
 	bool Engine::IsWall(pos_t pos) const
@@ -1037,31 +1210,16 @@ namespace tutorial
 
 	Entity* Engine::GetClosestMonster(pos_t pos, float range) const
 	{
-		Entity* closest = nullptr;
-		float bestDistance = 1E6f;
-
-		for (const auto& entity : entities_) {
-			if (entity->GetFaction() == Faction::MONSTER
-			    && entity->GetDestructible()
-			    && !entity->GetDestructible()->IsDead())
-
-			{
-				float distance =
-				    entity->GetDistance(pos.x, pos.y);
-				if (distance < bestDistance
-				    && (distance <= range || range == 0.0f)) {
-					bestDistance = distance;
-					closest = entity.get();
-				}
-			}
-		}
-
-		return closest;
+		return entities_.Nearest(pos, range, [](const Entity& entity) {
+			return entity.GetFaction() == Faction::MONSTER
+			       && entity.GetDestructible()
+			       && !entity.GetDestructible()->IsDead();
+		});
 	}
 
 	Entity* Engine::GetStairs() const
 	{
-		return stairs_;
+		return entities_.Get(stairs_);
 	}
 
 	int Engine::GetDungeonLevel() const
@@ -1071,19 +1229,20 @@ namespace tutorial
 
 	Engine::PlayerState Engine::SavePlayerState()
 	{
-		std::string name = player_ ? player_->GetName() : "player";
-		AttackerComponent attacker = (player_ && player_->GetAttacker())
-		                                 ? *player_->GetAttacker()
+		Entity* player = GetPlayer();
+		std::string name = player ? player->GetName() : "player";
+		AttackerComponent attacker = (player && player->GetAttacker())
+		                                 ? *player->GetAttacker()
 		                                 : AttackerComponent { 5 };
 		DestructibleComponent destructible =
-		    (player_ && player_->GetDestructible())
-		        ? *player_->GetDestructible()
+		    (player && player->GetDestructible())
+		        ? *player->GetDestructible()
 		        : DestructibleComponent { 1, 30, 30 };
 
 		PlayerState state(name, attacker, destructible);
 
-		if (player_) {
-			if (auto* playerPtr = dynamic_cast<Player*>(player_)) {
+		if (player) {
+			if (auto* playerPtr = dynamic_cast<Player*>(player)) {
 				size_t invSize = playerPtr->GetInventorySize();
 				for (size_t i = 0; i < invSize; ++i) {
 					auto item =
@@ -1101,28 +1260,7 @@ namespace tutorial
 
 	void Engine::LoadLevelConfiguration(int dungeonLevel)
 	{
-		std::string levelConfigPath;
-
-		if (dungeonLevel == 1) {
-			levelConfigPath = "data/levels/dungeon_1.json";
-		} else if (dungeonLevel == 2) {
-			levelConfigPath = "data/levels/dungeon_2.json";
-		} else {
-			levelConfigPath = "data/levels/dungeon_2.json";
-		}
-
-		try {
-			currentLevel_ =
-			    LevelConfig::LoadFromFile(levelConfigPath);
-			std::cout << "[Engine] Loaded level config: "
-			          << currentLevel_.id << std::endl;
-		} catch (const std::exception& e) {
-			std::cerr << "[Engine] Failed to load level config: "
-			          << e.what() << ", using dungeon_1"
-			          << std::endl;
-			currentLevel_ = LevelConfig::LoadFromFile(
-			    "data/levels/dungeon_1.json");
-		}
+		currentLevel_ = LevelConfig::LoadForDepth(dungeonLevel);
 
 		try {
 			DynamicSpawnSystem::Instance().Clear();
@@ -1139,16 +1277,16 @@ namespace tutorial
 	void Engine::ClearCurrentLevel()
 	{
 		entities_.Clear();
-		eventQueue_.clear();
+		eventQueue_.Clear();
 		entitiesToRemove_.clear();
-		player_ = nullptr;
-		stairs_ = nullptr;
+		pathCache_.Clear();
+		player_ = EntityHandle {};
+		stairs_ = EntityHandle {};
 	}
 
 	void Engine::PopulateLevelWithEntities()
 	{
-		GenerateMap(currentLevel_.generation.width,
-		            currentLevel_.generation.height);
+		GenerateMap();
 		map_->Update();
 
 		auto rooms = map_->GetRooms();
@@ -1158,20 +1296,15 @@ namespace tutorial
 			return;
 		}
 
-		for (auto it = rooms.begin() + 1; it != rooms.end(); ++it) {
-			entities_.PlaceItems(*it, currentLevel_.itemSpawning,
-			                     currentLevel_.id);
-			entities_.PlaceEntities(*it,
-			                        currentLevel_.monsterSpawning,
-			                        currentLevel_.id);
-		}
+		entities_.PopulateRooms(rooms.begin() + 1, rooms.end(),
+		                        currentLevel_);
 
 		if (!rooms.empty()) {
 			pos_t stairsPos = rooms.back().GetCenter();
 			auto stairsEntity = TemplateRegistry::Instance().Create(
 			    "stairs_down", stairsPos);
-			stairs_ =
-			    entities_.Spawn(std::move(stairsEntity)).get();
+			stairs_ = entities_.Spawn(std::move(stairsEntity))
+				      ->GetHandle();
 			std::cout << "[Engine] Placed stairs at ("
 			          << stairsPos.x << ", " << stairsPos.y << ")"
 			          << std::endl;
@@ -1189,17 +1322,19 @@ namespace tutorial
 			playerEntity->AddToInventory(std::move(item));
 		}
 
-		player_ = entities_.Spawn(std::move(playerEntity)).get();
+		player_ = entities_.Spawn(std::move(playerEntity))->GetHandle();
 	}
 
 	void Engine::RecreatePlayerUI()
 	{
 		auto& cfg = ConfigManager::Instance();
 
+		Entity* player = GetPlayer();
+
 		healthBar_ = std::make_unique<HealthBar>(
 		    cfg.GetHealthBarWidth(), cfg.GetHealthBarHeight(),
 		    pos_t { cfg.GetHealthBarX(), cfg.GetHealthBarY() },
-		    *player_);
+		    *player);
 
 		int invWidth = cfg.GetInventoryWindowWidth();
 		int invHeight = cfg.GetInventoryWindowHeight();
@@ -1207,7 +1342,7 @@ namespace tutorial
 		    invWidth, invHeight, cfg.GetInventoryCenterOnScreen());
 
 		inventoryWindow_ = std::make_unique<InventoryWindow>(
-		    invWidth, invHeight, invPos, *player_);
+		    invWidth, invHeight, invPos, *player);
 	}
 
 	pos_t Engine::CalculateWindowPosition(int width, int height,
@@ -1235,9 +1370,17 @@ namespace tutorial
 		    { 255, 60, 60 }, false);
 
 		PlayerState savedState = SavePlayerState();
-		LoadLevelConfiguration(dungeonLevel_);
-		ClearCurrentLevel();
-		PopulateLevelWithEntities();
+		if (auto prepared = levelPrefetcher_.Take(dungeonLevel_)) {
+			ClearCurrentLevel();
+			AdoptPreparedLevel(*prepared);
+		} else {
+			ScopedLevelRandom levelRandom(
+			    RandomService::Instance().GetMasterSeed(),
+			    dungeonLevel_);
+			LoadLevelConfiguration(dungeonLevel_);
+			ClearCurrentLevel();
+			PopulateLevelWithEntities();
+		}
 
 		auto rooms = map_->GetRooms();
 		if (!rooms.empty()) {
@@ -1256,6 +1399,47 @@ namespace tutorial
 
 		windowState_ = MainGame;
 		eventHandler_ = std::make_unique<MainGameEventHandler>(*this);
+
+		PrefetchNextLevel();
+	}
+
+	void Engine::PrefetchNextLevel()
+	{
+		levelPrefetcher_.Start(
+		    dungeonLevel_ + 1,
+		    RandomService::Instance().GetMasterSeed(),
+		    pos_t { map_->GetWidth(), map_->GetHeight() },
+		    ConfigManager::Instance().GetScentConfig());
+	}
+
+	void Engine::AdoptPreparedLevel(PreparedLevel& level)
+	{
+		currentLevel_ = std::move(level.config);
+
+		// Keep the shared tables in step with currentLevel_, as
+		// LoadLevelConfiguration would
+		try {
+			DynamicSpawnSystem::Instance().Clear();
+			DynamicSpawnSystem::Instance().BuildSpawnTablesForLevel(
+			    currentLevel_);
+		} catch (const std::exception& e) {
+			std::cerr
+			    << "[Engine] FATAL: Failed to build spawn tables: "
+			    << e.what() << std::endl;
+			throw;
+		}
+
+		map_ = std::move(level.map);
+		entities_.SpawnBatch(std::move(level.entities));
+
+		if (level.stairs) {
+			pos_t stairsPos = level.stairs->GetPos();
+			stairs_ = entities_.Spawn(std::move(level.stairs))
+				      ->GetHandle();
+			std::cout << "[Engine] Placed stairs at ("
+			          << stairsPos.x << ", " << stairsPos.y << ")"
+			          << std::endl;
+		}
 	}
 
 	bool Engine::PickATile(pos_t* pos, float maxRange,
@@ -1286,25 +1470,12 @@ namespace tutorial
 
 	Entity* Engine::GetActor(pos_t pos) const
 	{
-		for (const auto& entity : entities_) {
-			if (entity->GetPos() == pos && entity->GetDestructible()
-			    && !entity->GetDestructible()->IsDead()) {
-				return entity.get();
-			}
-		}
-		return nullptr;
+		return entities_.GetActor(pos);
 	}
 
 	int Engine::GetMaxRenderPriorityAtPosition(pos_t pos) const
 	{
-		int maxPriority = 0;
-		for (const auto& entity : entities_) {
-			if (entity->GetPos() == pos) {
-				maxPriority = std::max(
-				    maxPriority, entity->GetRenderPriority());
-			}
-		}
-		return maxPriority;
+		return entities_.GetMaxRenderPriority(pos);
 	}
 
 	void Engine::DealDamage(Entity& target, unsigned int damage)
@@ -1319,9 +1490,7 @@ namespace tutorial
 		if (target.GetDestructible()->IsDead()) {
 			// Create and execute DieAction to handle XP, messages,
 			// etc.
-			std::unique_ptr<Event> dieAction =
-			    std::make_unique<DieAction>(*this, target);
-			dieAction->Execute();
+			DieAction(*this, target).Execute();
 		}
 	}
 
@@ -1332,12 +1501,22 @@ namespace tutorial
 
 		map_->Render(gameConsole_);
 
-		// Render all entities in FOV
-		for (const auto& entity : entities_) {
-			const auto pos = entity->GetPos();
+		// Render all entities in FOV. Cull over the pooled positions
+		// first, then put only the survivors in render order.
+		const auto& components = entities_.GetComponents();
+
+		visibleIds_.clear();
+		components.positions.ForEach([&](EntityId id, pos_t pos) {
 			if (map_->IsInFov(pos)) {
-				const auto& renderable =
-				    entity->GetRenderable();
+				visibleIds_.push_back(id);
+			}
+		});
+		entities_.SortByRenderOrder(visibleIds_);
+
+		for (EntityId id : visibleIds_) {
+			const auto* renderable = components.renderables.Get(id);
+			if (renderable) {
+				pos_t pos = *components.positions.Get(id);
 				renderable->Render(gameConsole_, pos);
 			}
 		}
@@ -1502,30 +1681,24 @@ namespace tutorial
 	}
 
 	// Private methods
-	void Engine::AddEvent(Event_ptr& event)
+	void Engine::AddEvent(ActionRecord action)
 	{
-		eventQueue_.push_back(std::move(event));
+		eventQueue_.PushBack(std::move(action));
 	}
 
-	void Engine::GenerateMap(int width, int height)
+	void Engine::GenerateMap()
 	{
-		// Use DCSS-style basic dungeon generator
-		auto config =
-		    BasicDungeonGenerator::GetDefaultConfig(width, height);
-
-		// Override with level-specific settings if desired
-		config.maxRooms = currentLevel_.generation.maxRooms;
-		config.minRoomSize = currentLevel_.generation.minRoomSize;
-		config.maxRoomSize = currentLevel_.generation.maxRoomSize;
-
-		BasicDungeonGenerator generator(config);
-		map_->Generate(generator);
-		map_->Update();
+		LevelPrefetcher::GenerateMap(*map_, currentLevel_);
 	}
 
 	void Engine::ProcessDeferredRemovals()
 	{
-		for (Entity* entity : entitiesToRemove_) {
+		for (EntityHandle handle : entitiesToRemove_) {
+			Entity* entity = entities_.Get(handle);
+			if (!entity) {
+				continue;
+			}
+
 			std::string corpseName =
 			    "remains of " + entity->GetName();
 			pos_t corpsePos = entity->GetPos();
@@ -1551,11 +1724,11 @@ namespace tutorial
 			// keep HealthBar reference valid Only nullify
 			// the pointer so game logic knows player is
 			// dead
-			if (entity == player_) {
-				player_ = nullptr;
+			if (handle == player_) {
+				player_ = EntityHandle {};
 			} else {
 				// Remove non-player entities normally
-				RemoveEntity(entity);
+				RemoveEntity(handle);
 			}
 		}
 
@@ -2,10 +2,12 @@
 
 #include "AiComponent.hpp"
 #include "Colors.hpp"
+#include "ComponentStore.hpp"
 #include "Components.hpp"
 #include "ConfigManager.hpp"
 #include "Engine.hpp"
 #include "SpellcasterComponent.hpp"
+#include "TurnScheduler.hpp"
 #include "Util.hpp"
 
 #include <cmath>
@@ -15,7 +17,27 @@ namespace tutorial
 	inline namespace
 	{
 		static const IconRenderable kDeadIcon { color::dark_red, '%' };
-	}
+
+		// File an owned component in pool, leaving owned empty
+		template <typename T>
+		void MoveIn(ComponentPool<T>& pool, EntityId id,
+		            std::unique_ptr<T>& owned)
+		{
+			if (owned) {
+				pool.Insert(id, std::move(*owned));
+				owned.reset();
+			}
+		}
+
+		template <typename T>
+		void MoveOut(ComponentPool<T>& pool, EntityId id,
+		             std::unique_ptr<T>& owned)
+		{
+			if (pool.Has(id)) {
+				owned = std::make_unique<T>(pool.Extract(id));
+			}
+		}
+	} // namespace
 
 	// BaseEntity Constructor
 	BaseEntity::BaseEntity(
@@ -28,18 +50,21 @@ namespace tutorial
 	    : name_(name),
 	      pluralName_(name),
 	      templateId_(""),
+	      store_(nullptr),
 	      renderable_(std::make_unique<IconRenderable>(renderable)),
 	      defense_(std::make_unique<DestructibleComponent>(defense)),
 	      attack_(std::make_unique<AttackerComponent>(attack)),
 	      item_(std::move(item)),
 	      spellcaster_(std::move(spellcaster)),
 	      pos_(pos),
+	      handle_(),
 	      faction_(faction),
 	      blocker_(blocker),
 	      pickable_(pickable),
 	      isCorpse_(isCorpse),
 	      renderPriority_(0),
-	      stackCount_(1)
+	      stackCount_(1),
+	      speed_(TurnScheduler::kNormalSpeed)
 	{
 	}
 
@@ -53,7 +78,12 @@ namespace tutorial
 		// Only update visual representation
 		// Gameplay state changes (removing components, blocker status)
 		// are handled by the death event system
-		renderable_ = std::make_unique<IconRenderable>(kDeadIcon);
+		if (store_) {
+			store_->renderables.Insert(handle_.index, kDeadIcon);
+		} else {
+			renderable_ =
+			    std::make_unique<IconRenderable>(kDeadIcon);
+		}
 	}
 
 	void BaseEntity::Use(Engine& engine)
@@ -65,7 +95,11 @@ namespace tutorial
 
 	void BaseEntity::SetPos(pos_t pos)
 	{
-		pos_ = pos;
+		if (store_) {
+			*store_->positions.Get(handle_.index) = pos;
+		} else {
+			pos_ = pos;
+		}
 	}
 
 	Item* BaseEntity::GetItem() const
@@ -85,28 +119,42 @@ namespace tutorial
 
 	bool BaseEntity::CanAct() const
 	{
-		return (defense_ && !defense_->IsDead());
+		const DestructibleComponent* defense = GetDestructible();
+		return (defense && !defense->IsDead());
 	}
 
 	AttackerComponent* BaseEntity::GetAttacker() const
 	{
-		return attack_.get();
+		return store_ ? store_->attackers.Get(handle_.index)
+		              : attack_.get();
 	}
 
 	DestructibleComponent* BaseEntity::GetDestructible() const
 	{
-		return defense_.get();
+		return store_ ? store_->destructibles.Get(handle_.index)
+		              : defense_.get();
 	}
 
 	SpellcasterComponent* BaseEntity::GetSpellcaster() const
 	{
-		return spellcaster_.get();
+		return store_ ? store_->spellcasters.Get(handle_.index)
+		              : spellcaster_.get();
 	}
 
 	void BaseEntity::SetSpellcaster(
 	    std::unique_ptr<SpellcasterComponent> spellcaster)
 	{
-		spellcaster_ = std::move(spellcaster);
+		if (!store_) {
+			spellcaster_ = std::move(spellcaster);
+			return;
+		}
+
+		auto& pool = store_->spellcasters;
+		if (spellcaster) {
+			pool.Insert(handle_.index, std::move(*spellcaster));
+		} else if (pool.Has(handle_.index)) {
+			pool.Extract(handle_.index);
+		}
 	}
 
 	const std::string& BaseEntity::GetName() const
@@ -121,12 +169,13 @@ namespace tutorial
 
 	const RenderableComponent* BaseEntity::GetRenderable() const
 	{
-		return renderable_.get();
+		return store_ ? store_->renderables.Get(handle_.index)
+		              : renderable_.get();
 	}
 
 	pos_t BaseEntity::GetPos() const
 	{
-		return pos_;
+		return store_ ? *store_->positions.Get(handle_.index) : pos_;
 	}
 
 	bool BaseEntity::IsBlocker() const
@@ -136,8 +185,9 @@ namespace tutorial
 
 	float BaseEntity::GetDistance(int cx, int cy) const
 	{
-		int dx = pos_.x - cx;
-		int dy = pos_.y - cy;
+		pos_t pos = GetPos();
+		int dx = pos.x - cx;
+		int dy = pos.y - cy;
 		return std::sqrt(dx * dx + dy * dy);
 	}
 
@@ -166,6 +216,16 @@ namespace tutorial
 		stackCount_ = count;
 	}
 
+	int BaseEntity::GetSpeed() const
+	{
+		return speed_;
+	}
+
+	void BaseEntity::SetSpeed(int speed)
+	{
+		speed_ = speed;
+	}
+
 	const std::string& BaseEntity::GetPluralName() const
 	{
 		return pluralName_;
@@ -186,13 +246,49 @@ namespace tutorial
 		templateId_ = templateId;
 	}
 
+	EntityHandle BaseEntity::GetHandle() const
+	{
+		return handle_;
+	}
+
+	void BaseEntity::SetHandle(EntityHandle handle)
+	{
+		handle_ = handle;
+	}
+
+	void BaseEntity::AttachComponents(ComponentStore& store)
+	{
+		EntityId id = handle_.index;
+		store.positions.Insert(id, pos_);
+		MoveIn(store.destructibles, id, defense_);
+		MoveIn(store.attackers, id, attack_);
+		MoveIn(store.renderables, id, renderable_);
+		MoveIn(store.spellcasters, id, spellcaster_);
+		store_ = &store;
+	}
+
+	void BaseEntity::DetachComponents()
+	{
+		if (!store_) {
+			return;
+		}
+
+		EntityId id = handle_.index;
+		pos_ = store_->positions.Extract(id);
+		MoveOut(store_->destructibles, id, defense_);
+		MoveOut(store_->attackers, id, attack_);
+		MoveOut(store_->renderables, id, renderable_);
+		MoveOut(store_->spellcasters, id, spellcaster_);
+		store_ = nullptr;
+	}
+
 	RenderLayer BaseEntity::GetRenderLayer() const
 	{
 		if (isCorpse_) {
 			return RenderLayer::CORPSES;
 		}
 
-		if (!defense_) {
+		if (!GetDestructible()) {
 			return RenderLayer::CORPSES;
 		}
 
@@ -224,18 +320,49 @@ namespace tutorial
 
 	void Npc::Act(Engine& engine)
 	{
-		if (defense_ && defense_->IsDead()) {
+		const DestructibleComponent* defense = GetDestructible();
+		if (defense && defense->IsDead()) {
 			return;
 		}
 
-		ai_->Perform(engine, *this);
+		AiComponent* ai =
+		    store_ ? store_->ai.Get(handle_.index)->get() : ai_.get();
+		ai->Perform(engine, *this);
+	}
+
+	void Npc::Act(Engine& engine, const AiIntent& intent)
+	{
+		const DestructibleComponent* defense = GetDestructible();
+		if (defense && defense->IsDead()) {
+			return;
+		}
+
+		AiComponent* ai =
+		    store_ ? store_->ai.Get(handle_.index)->get() : ai_.get();
+		ai->Commit(engine, *this, intent);
+	}
+
+	void Npc::AttachComponents(ComponentStore& store)
+	{
+		BaseEntity::AttachComponents(store);
+		store.ai.Insert(handle_.index, std::move(ai_));
+	}
+
+	void Npc::DetachComponents()
+	{
+		if (store_) {
+			ai_ = store_->ai.Extract(handle_.index);
+		}
+		BaseEntity::DetachComponents();
 	}
 
 	std::unique_ptr<AiComponent> Npc::SwapAi(
 	    std::unique_ptr<AiComponent> newAi)
 	{
-		std::unique_ptr<AiComponent> oldAi = std::move(ai_);
-		ai_ = std::move(newAi);
+		std::unique_ptr<AiComponent>& ai =
+		    store_ ? *store_->ai.Get(handle_.index) : ai_;
+		std::unique_ptr<AiComponent> oldAi = std::move(ai);
+		ai = std::move(newAi);
 		return oldAi;
 	}
 } // namespace tutorial
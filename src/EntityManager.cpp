@@ -3,60 +3,322 @@
 #include "DynamicSpawnSystem.hpp"
 #include "LevelConfig.hpp"
 #include "Map.hpp"
+#include "Random.hpp"
 #include "RenderLayer.hpp"
 #include "TemplateRegistry.hpp"
+#include "Util.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <libtcod/mersenne.hpp>
+#include <limits>
 #include <memory>
 
 namespace tutorial
 {
 	void EntityManager::Clear()
 	{
-		entities_.clear();
+		buckets_.clear();
+		size_ = 0;
+		freeSlots_.clear();
+
+		for (std::uint32_t i = 0; i < slots_.size(); ++i) {
+			auto& slot = slots_[i];
+			if (slot.entity) {
+				slot.entity.reset();
+				++slot.generation;
+			}
+			freeSlots_.push_back(i);
+		}
+		components_.Clear();
+		scheduler_.Clear();
+
+		for (auto& occupants : occupants_) {
+			occupants.clear();
+		}
+		std::fill(blockers_.begin(), blockers_.end(), nullptr);
+
+		for (auto& cell : cells_) {
+			cell.clear();
+		}
+	}
+
+	void EntityManager::Resize(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+
+		occupants_.assign(width * height, {});
+		blockers_.assign(width * height, nullptr);
+
+		cellsWide_ = (width + kCellSize - 1) / kCellSize;
+		cellsHigh_ = (height + kCellSize - 1) / kCellSize;
+		cells_.assign(cellsWide_ * cellsHigh_, {});
+
+		for (auto* entity : *this) {
+			AddToIndex(entity);
+		}
+	}
+
+	void EntityManager::SetPos(Entity& entity, pos_t pos)
+	{
+		RemoveFromIndex(&entity);
+		entity.SetPos(pos);
+		AddToIndex(&entity);
 	}
 
 	Entity* EntityManager::GetBlockingEntity(pos_t pos) const
 	{
-		for (auto& entity : entities_) {
-			if (pos == entity->GetPos() && entity->IsBlocker()) {
-				return entity.get();
+		if (!IsIndexed(pos)) {
+			return nullptr;
+		}
+
+		return blockers_[util::posToIndex(pos, width_)];
+	}
+
+	Entity* EntityManager::GetActor(pos_t pos) const
+	{
+		// Pick the living entity that renders lowest on the tile, the
+		// same one a scan of the render-sorted list would find first
+		Entity* actor = nullptr;
+
+		for (auto* entity : GetEntitiesAt(pos)) {
+			if (!entity->GetDestructible()
+			    || entity->GetDestructible()->IsDead()) {
+				continue;
+			}
+
+			if (!actor
+			    || entity->GetRenderLayer()
+				   < actor->GetRenderLayer()
+			    || (entity->GetRenderLayer()
+			            == actor->GetRenderLayer()
+			        && entity->GetRenderPriority()
+			               < actor->GetRenderPriority())) {
+				actor = entity;
 			}
 		}
 
-		return nullptr;
+		return actor;
 	}
 
-	void EntityManager::SortByRenderLayer()
+	int EntityManager::GetMaxRenderPriority(pos_t pos) const
 	{
-		// Stable sort by (layer, priority) - preserves insertion order
-		// for equal elements
-		std::stable_sort(
-		    entities_.begin(), entities_.end(),
-		    [](const Entity_ptr& a, const Entity_ptr& b) {
-			    RenderLayer layerA = a->GetRenderLayer();
-			    RenderLayer layerB = b->GetRenderLayer();
+		int maxPriority = 0;
 
-			    // First compare by layer
-			    if (layerA != layerB) {
-				    return static_cast<int>(layerA)
-				           < static_cast<int>(layerB);
-			    }
+		for (const auto* entity : GetEntitiesAt(pos)) {
+			maxPriority =
+			    std::max(maxPriority, entity->GetRenderPriority());
+		}
 
-			    // Within same layer, compare by render priority
-			    return a->GetRenderPriority()
-			           < b->GetRenderPriority();
-		    });
+		return maxPriority;
 	}
 
-	void EntityManager::PlaceEntitiesFromTable(
-	    const Room& room, const SpawnTable* table,
-	    const SpawnConfig& spawnConfig, bool checkBlockingOnly)
+	const std::vector<Entity*>& EntityManager::GetEntitiesAt(
+	    pos_t pos) const
 	{
-		auto* rand = TCODRandom::getInstance();
+		static const std::vector<Entity*> kEmpty;
 
-		if (rand->getFloat(0.0f, 1.0f) > spawnConfig.spawnChance) {
+		if (!IsIndexed(pos)) {
+			return kEmpty;
+		}
+
+		return occupants_[util::posToIndex(pos, width_)];
+	}
+
+	bool EntityManager::IsIndexed(pos_t pos) const
+	{
+		return (pos.x >= 0 && pos.y >= 0 && pos.x < width_
+		        && pos.y < height_);
+	}
+
+	void EntityManager::AddToIndex(Entity* entity)
+	{
+		pos_t pos = entity->GetPos();
+		if (!IsIndexed(pos)) {
+			return;
+		}
+
+		int index = util::posToIndex(pos, width_);
+		occupants_[index].push_back(entity);
+
+		if (entity->IsBlocker() && !blockers_[index]) {
+			blockers_[index] = entity;
+		}
+
+		cells_[util::posToIndex(
+		           pos_t { pos.x / kCellSize, pos.y / kCellSize },
+		           cellsWide_)]
+		    .push_back(entity);
+	}
+
+	void EntityManager::RemoveFromIndex(Entity* entity)
+	{
+		pos_t pos = entity->GetPos();
+		if (!IsIndexed(pos)) {
+			return;
+		}
+
+		int index = util::posToIndex(pos, width_);
+		auto& occupants = occupants_[index];
+		auto it = std::find(occupants.begin(), occupants.end(), entity);
+		if (it != occupants.end()) {
+			occupants.erase(it);
+		}
+
+		// Hand the blocker slot to any other blocker still on the tile
+		if (blockers_[index] == entity) {
+			blockers_[index] = nullptr;
+			for (auto* other : occupants) {
+				if (other->IsBlocker()) {
+					blockers_[index] = other;
+					break;
+				}
+			}
+		}
+
+		// Cell order carries no meaning, so swap and pop
+		auto& cell = cells_[util::posToIndex(
+		    pos_t { pos.x / kCellSize, pos.y / kCellSize },
+		    cellsWide_)];
+		auto cellIt = std::find(cell.begin(), cell.end(), entity);
+		if (cellIt != cell.end()) {
+			*cellIt = cell.back();
+			cell.pop_back();
+		}
+	}
+
+	void EntityManager::QueryRect(pos_t min, pos_t max,
+	                              std::vector<Entity*>& out) const
+	{
+		min.x = std::max(min.x, 0);
+		min.y = std::max(min.y, 0);
+		max.x = std::min(max.x, width_ - 1);
+		max.y = std::min(max.y, height_ - 1);
+		if (min.x > max.x || min.y > max.y) {
+			return;
+		}
+
+		for (int cy = min.y / kCellSize; cy <= max.y / kCellSize;
+		     ++cy) {
+			for (int cx = min.x / kCellSize;
+			     cx <= max.x / kCellSize; ++cx) {
+				const auto& cell = cells_[util::posToIndex(
+				    pos_t { cx, cy }, cellsWide_)];
+				for (auto* entity : cell) {
+					pos_t pos = entity->GetPos();
+					if (pos.x >= min.x && pos.x <= max.x
+					    && pos.y >= min.y
+					    && pos.y <= max.y) {
+						out.push_back(entity);
+					}
+				}
+			}
+		}
+	}
+
+	void EntityManager::QueryRadius(pos_t center, float radius,
+	                                std::vector<Entity*>& out) const
+	{
+		if (radius < 0.0f) {
+			return;
+		}
+
+		// d <= r exactly when the integer d^2 <= floor(r^2)
+		int reach = static_cast<int>(radius);
+		int limit = static_cast<int>(radius * radius);
+		std::size_t first = out.size();
+
+		QueryRect(pos_t { center.x - reach, center.y - reach },
+		          pos_t { center.x + reach, center.y + reach }, out);
+
+		auto outside = [center, limit](const Entity* entity) {
+			pos_t delta = entity->GetPos() - center;
+			return delta.x * delta.x + delta.y * delta.y > limit;
+		};
+		out.erase(std::remove_if(out.begin() + first, out.end(),
+		                         outside),
+		          out.end());
+	}
+
+	Entity* EntityManager::Nearest(
+	    pos_t center, float range,
+	    const std::function<bool(const Entity&)>& filter) const
+	{
+		if (cells_.empty()) {
+			return nullptr;
+		}
+
+		bool unlimited = (range == 0.0f);
+		int limit = unlimited ? std::numeric_limits<int>::max()
+		                      : static_cast<int>(range * range);
+
+		Entity* best = nullptr;
+		int bestDistance = std::numeric_limits<int>::max();
+
+		pos_t home {
+			std::clamp(center.x / kCellSize, 0, cellsWide_ - 1),
+			std::clamp(center.y / kCellSize, 0, cellsHigh_ - 1)
+		};
+		int maxRing = std::max(cellsWide_, cellsHigh_);
+		if (!unlimited) {
+			maxRing = std::min(
+			    maxRing, static_cast<int>(range) / kCellSize + 1);
+		}
+
+		auto visit = [&](int cx, int cy) {
+			if (cx < 0 || cy < 0 || cx >= cellsWide_
+			    || cy >= cellsHigh_) {
+				return;
+			}
+
+			for (auto* entity : cells_[util::posToIndex(
+			         pos_t { cx, cy }, cellsWide_)]) {
+				pos_t delta = entity->GetPos() - center;
+				int distance =
+				    delta.x * delta.x + delta.y * delta.y;
+				if (distance < bestDistance && distance <= limit
+				    && filter(*entity)) {
+					bestDistance = distance;
+					best = entity;
+				}
+			}
+		};
+
+		for (int ring = 0; ring <= maxRing; ++ring) {
+			// Every tile in this ring is at least this far away on
+			// one axis, so a closer match already found is final
+			int nearest = std::max(0, (ring - 1) * kCellSize + 1);
+			if (best && nearest * nearest > bestDistance) {
+				break;
+			}
+
+			if (ring == 0) {
+				visit(home.x, home.y);
+				continue;
+			}
+
+			for (int i = -ring; i <= ring; ++i) {
+				visit(home.x + i, home.y - ring);
+				visit(home.x + i, home.y + ring);
+			}
+			for (int i = -ring + 1; i <= ring - 1; ++i) {
+				visit(home.x - ring, home.y + i);
+				visit(home.x + ring, home.y + i);
+			}
+		}
+
+		return best;
+	}
+
+	void EntityManager::PlanFromTable(const Room& room,
+	                                  const SpawnTable* table,
+	                                  const SpawnConfig& spawnConfig,
+	                                  bool checkBlockingOnly,
+	                                  SpawnPlan& plan) const
+	{
+		auto& rand = GetRandom(RandomStream::Spawning);
+
+		if (rand.GetFloat(0.0f, 1.0f) > spawnConfig.spawnChance) {
 			return;
 		}
 
@@ -65,27 +327,23 @@ namespace tutorial
 		}
 
 		int maxEntities = spawnConfig.maxPerRoom;
-		int numEntities = rand->getInt(0, maxEntities);
+		int numEntities = rand.GetInt(0, maxEntities);
 
 		for (int i = 0; i < numEntities; ++i) {
 			auto origin = room.GetOrigin();
 			auto end = room.GetEnd();
-			int x = rand->getInt(origin.x + 1, end.x - 1);
-			int y = rand->getInt(origin.y + 1, end.y - 1);
+			int x = rand.GetInt(origin.x + 1, end.x - 1);
+			int y = rand.GetInt(origin.y + 1, end.y - 1);
 			pos_t pos { x, y };
 
-			bool blocked = false;
-			if (checkBlockingOnly) {
-				blocked = (GetBlockingEntity(pos) != nullptr);
-			} else {
-				for (const auto& entity : entities_) {
-					if (entity->GetPos() == pos) {
-						blocked = true;
-						break;
-					}
-				}
+			if (!IsIndexed(pos)) {
+				continue;
 			}
 
+			int index = util::posToIndex(pos, width_);
+			bool blocked = checkBlockingOnly ? plan.blocked[index]
+			                                 : plan.occupied[index];
+
 			if (blocked) {
 				continue;
 			}
@@ -97,73 +355,194 @@ namespace tutorial
 
 			auto entity =
 			    TemplateRegistry::Instance().Create(templateId, pos);
-			Spawn(std::move(entity));
+			if (!entity) {
+				continue;
+			}
+
+			plan.occupied[index] = true;
+			if (entity->IsBlocker()) {
+				plan.blocked[index] = true;
+			}
+
+			plan.batch.push_back(std::move(entity));
 		}
 	}
 
-	void EntityManager::PlaceEntities(const Room& room,
-	                                  const SpawnConfig& spawnConfig,
-	                                  const std::string& levelId)
+	void EntityManager::PopulateRooms(
+	    std::vector<Room>::const_iterator first,
+	    std::vector<Room>::const_iterator last, const LevelConfig& level)
 	{
+		SpawnBatch(RollRooms(first, last, level,
+		                     DynamicSpawnSystem::Instance()));
+	}
+
+	std::vector<EntityManager::Entity_ptr> EntityManager::RollRooms(
+	    std::vector<Room>::const_iterator first,
+	    std::vector<Room>::const_iterator last, const LevelConfig& level,
+	    const DynamicSpawnSystem& spawns) const
+	{
+		const SpawnTable* itemTable = spawns.GetItemTable(level.id);
 		const SpawnTable* monsterTable =
-		    DynamicSpawnSystem::Instance().GetMonsterTable(levelId);
+		    spawns.GetMonsterTable(level.id);
+
+		if (!itemTable) {
+			std::cerr
+			    << "[EntityManager] No item spawn table found for "
+			    << level.id << std::endl;
+		}
 
 		if (!monsterTable) {
 			std::cerr << "[EntityManager] No monster spawn table "
 			             "found for "
-			          << levelId << std::endl;
-			return;
+			          << level.id << std::endl;
+		}
+
+		// Seed the bitmaps from whatever is already on the level
+		SpawnPlan plan;
+		plan.occupied.assign(occupants_.size(), false);
+		plan.blocked.assign(blockers_.size(), false);
+
+		for (std::size_t i = 0; i < occupants_.size(); ++i) {
+			plan.occupied[i] = !occupants_[i].empty();
+			plan.blocked[i] = (blockers_[i] != nullptr);
+		}
+
+		if (itemTable) {
+			for (auto it = first; it != last; ++it) {
+				PlanFromTable(*it, itemTable,
+				              level.itemSpawning, false,
+				              plan);
+			}
+		}
+
+		if (monsterTable) {
+			for (auto it = first; it != last; ++it) {
+				PlanFromTable(*it, monsterTable,
+				              level.monsterSpawning, true,
+				              plan);
+			}
 		}
 
-		PlaceEntitiesFromTable(room, monsterTable, spawnConfig, true);
+		return std::move(plan.batch);
 	}
 
-	std::unique_ptr<Entity>& EntityManager::Spawn(
-	    std::unique_ptr<Entity>&& src)
+	Entity* EntityManager::Spawn(std::unique_ptr<Entity>&& src)
 	{
-		auto& entity = entities_.emplace_back(std::move(src));
-		SortByRenderLayer();
+		std::uint32_t index;
+		if (!freeSlots_.empty()) {
+			index = freeSlots_.back();
+			freeSlots_.pop_back();
+		} else {
+			index = static_cast<std::uint32_t>(slots_.size());
+			slots_.emplace_back();
+		}
+
+		auto& slot = slots_[index];
+		slot.entity = std::move(src);
+
+		Entity* entity = slot.entity.get();
+		entity->SetHandle(EntityHandle { index, slot.generation });
+		entity->AttachComponents(components_);
+		AddToIndex(entity);
+
+		slot.renderKey.sequence = nextSequence_++;
+		AddToBuckets(slot);
+		++size_;
+
 		return entity;
 	}
 
-	std::unique_ptr<Entity>& EntityManager::Spawn(
-	    std::unique_ptr<Entity>&& src, pos_t pos)
+	Entity* EntityManager::Spawn(std::unique_ptr<Entity>&& src, pos_t pos)
 	{
 		src->SetPos(pos);
-		auto& entity = entities_.emplace_back(std::move(src));
-		SortByRenderLayer();
-		return entity;
+		return Spawn(std::move(src));
 	}
 
-	std::unique_ptr<Entity> EntityManager::Remove(Entity* entity)
+	void EntityManager::SpawnBatch(std::vector<Entity_ptr>&& batch)
 	{
-		for (auto it = entities_.begin(); it != entities_.end(); ++it) {
-			if (it->get() == entity) {
-				auto removed = std::move(*it);
-				entities_.erase(it);
-				return removed;
-			}
+		std::size_t fresh =
+		    batch.size() > freeSlots_.size()
+		        ? batch.size() - freeSlots_.size()
+		        : 0;
+		slots_.reserve(slots_.size() + fresh);
+
+		for (auto& entity : batch) {
+			Spawn(std::move(entity));
 		}
-		return nullptr;
+
+		batch.clear();
 	}
-} // namespace tutorial
 
-namespace tutorial
-{
-	void EntityManager::PlaceItems(const Room& room,
-	                               const SpawnConfig& spawnConfig,
-	                               const std::string& levelId)
+	Entity* EntityManager::Get(EntityHandle handle) const
 	{
-		const SpawnTable* itemTable =
-		    DynamicSpawnSystem::Instance().GetItemTable(levelId);
+		if (!IsValid(handle)) {
+			return nullptr;
+		}
 
-		if (!itemTable) {
-			std::cerr
-			    << "[EntityManager] No item spawn table found for "
-			    << levelId << std::endl;
-			return;
+		return slots_[handle.index].entity.get();
+	}
+
+	Entity* EntityManager::GetById(EntityId id) const
+	{
+		return id < slots_.size() ? slots_[id].entity.get() : nullptr;
+	}
+
+	void EntityManager::SortByRenderOrder(std::vector<EntityId>& ids) const
+	{
+		std::sort(ids.begin(), ids.end(),
+		          [this](EntityId lhs, EntityId rhs) {
+			          const Slot& a = slots_[lhs];
+			          const Slot& b = slots_[rhs];
+			          return (a.layer != b.layer)
+			                     ? a.layer < b.layer
+			                     : a.renderKey < b.renderKey;
+		          });
+	}
+
+	void EntityManager::AddToBuckets(Slot& slot)
+	{
+		Entity* entity = slot.entity.get();
+		slot.layer = entity->GetRenderLayer();
+		slot.renderKey.priority = entity->GetRenderPriority();
+		buckets_[slot.layer].emplace(slot.renderKey, entity);
+	}
+
+	void EntityManager::RemoveFromBuckets(const Slot& slot)
+	{
+		auto bucket = buckets_.find(slot.layer);
+		bucket->second.erase(slot.renderKey);
+		if (bucket->second.empty()) {
+			buckets_.erase(bucket);
 		}
+	}
+
+	bool EntityManager::IsValid(EntityHandle handle) const
+	{
+		return (handle.index < slots_.size()
+		        && slots_[handle.index].generation == handle.generation
+		        && slots_[handle.index].entity);
+	}
+
+	std::unique_ptr<Entity> EntityManager::Remove(EntityHandle handle)
+	{
+		Entity* entity = Get(handle);
+		if (!entity) {
+			return nullptr;
+		}
+
+		RemoveFromIndex(entity);
+		scheduler_.Remove(handle);
+
+		auto& slot = slots_[handle.index];
+		RemoveFromBuckets(slot);
+		--size_;
+
+		auto removed = std::move(slot.entity);
+		++slot.generation;
+		freeSlots_.push_back(handle.index);
 
-		PlaceEntitiesFromTable(room, itemTable, spawnConfig, false);
+		removed->DetachComponents();
+		removed->SetHandle(EntityHandle {});
+		return removed;
 	}
 } // namespace tutorial
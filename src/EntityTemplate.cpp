@@ -9,6 +9,7 @@
 #include "Position.hpp"
 #include "SpellcasterComponent.hpp"
 #include "TargetSelector.hpp"
+#include "TurnScheduler.hpp"
 
 #include <iostream>
 #include <stdexcept>
@@ -248,6 +249,9 @@ namespace tutorial
 		// XP reward (defaults to 0)
 		tpl.xp = j.value("xp", 0);
 
+		// Speed (defaults to one action per player turn)
+		tpl.speed = j.value("speed", TurnScheduler::kNormalSpeed);
+
 		// Required: AI type
 		if (!j.contains("ai")) {
 			throw std::runtime_error("Unit '" + id
@@ -277,13 +281,15 @@ namespace tutorial
 		destructible.SetXpReward(static_cast<unsigned int>(xp));
 
 		// Create monster entity
-		return std::make_unique<Npc>(
+		auto entity = std::make_unique<Npc>(
 		    pos, name, blocks,
 		    AttackerComponent { static_cast<unsigned int>(power) },
 		    destructible, IconRenderable { color, icon },
 		    Faction::MONSTER, std::move(aiComponent),
 		    false // Not pickable
 		);
+		entity->SetSpeed(speed);
+		return entity;
 	}
 
 	EntityTemplate EntityTemplate::FromJson(const std::string& id,
@@ -377,6 +383,9 @@ namespace tutorial
 		// Parse xpReward (optional, defaults to 0)
 		tpl.xpReward = j.value("xpReward", 0);
 
+		// Parse speed (optional, defaults to normal speed)
+		tpl.speed = j.value("speed", TurnScheduler::kNormalSpeed);
+
 		// AI is optional (items don't need it)
 		if (j.contains("ai")) {
 			tpl.aiType = j["ai"];
@@ -431,6 +440,7 @@ namespace tutorial
 		j["maxHp"] = maxHp;
 		j["defense"] = defense;
 		j["power"] = power;
+		j["speed"] = speed;
 		if (aiType.has_value()) {
 			j["ai"] = aiType.value();
 		}
@@ -564,6 +574,7 @@ namespace tutorial
 			    pickable);
 			entity->SetPluralName(pluralName);
 			entity->SetTemplateId(id);
+			entity->SetSpeed(speed);
 			return entity;
 		} else if (aiComponent != nullptr) {
 			// Monster with AI - create destructible with XP reward
@@ -584,6 +595,7 @@ namespace tutorial
 			    isCorpse);
 			entity->SetPluralName(pluralName);
 			entity->SetTemplateId(id);
+			entity->SetSpeed(speed);
 			return entity;
 		} else {
 			// Item or neutral entity without AI
@@ -600,6 +612,7 @@ namespace tutorial
 			    isCorpse);
 			entity->SetPluralName(pluralName);
 			entity->SetTemplateId(id);
+			entity->SetSpeed(speed);
 			return entity;
 		}
 	}
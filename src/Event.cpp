@@ -68,26 +68,37 @@ namespace tutorial
 
 namespace tutorial
 {
-	void Action::Execute()
+	Action::Action(Engine& engine, Entity& entity)
+	    : engine_(engine), entity_(entity.GetHandle())
 	{
-		if (!engine_.IsValid(entity_)) {
-			return;
-		}
+	}
+
+	Entity* Action::GetEntity() const
+	{
+		return engine_.GetEntity(entity_);
 	}
 } // namespace tutorial
 
 namespace tutorial
 {
-	AiAction::AiAction(Engine& engine, Entity& entity)
-	    : Action(engine, entity)
+	AiAction::AiAction(Engine& engine, Entity& entity,
+	                   const AiIntent& intent)
+	    : Action(engine, entity), intent_(intent)
 	{
 	}
 
 	void AiAction::Execute()
 	{
-		Action::Execute();
+		Entity* entity = GetEntity();
+		if (!entity) {
+			return;
+		}
 
-		entity_.Act(engine_);
+		if (auto* npc = dynamic_cast<Npc*>(entity)) {
+			npc->Act(engine_, intent_);
+		} else {
+			entity->Act(engine_);
+		}
 	}
 } // namespace tutorial
 
@@ -100,12 +111,15 @@ namespace tutorial
 
 	void DieAction::Execute()
 	{
-		Action::Execute();
+		Entity* entity = GetEntity();
+		if (!entity) {
+			return;
+		}
 
 		// Update visual state
-		entity_.Die();
+		entity->Die();
 
-		if (engine_.IsPlayer(entity_)) {
+		if (engine_.IsPlayer(*entity)) {
 			auto msg = LocaleManager::Instance().GetMessage(
 			    "messages.death.player");
 			engine_.LogMessage(msg.text, msg.color, msg.stack);
@@ -116,20 +130,20 @@ namespace tutorial
 			auto msg = LocaleManager::Instance().GetMessage(
 			    "messages.death.npc",
 			    { { "name",
-			        util::capitalize(entity_.GetName()) } });
+			        util::capitalize(entity->GetName()) } });
 			engine_.LogMessage(msg.text, msg.color, msg.stack);
 
 			// Grant XP to player when monster dies
-			if (entity_.GetDestructible()) {
+			if (entity->GetDestructible()) {
 				unsigned int xpReward =
-				    entity_.GetDestructible()->GetXpReward();
+				    entity->GetDestructible()->GetXpReward();
 				if (xpReward > 0) {
 					engine_.GrantXpToPlayer(xpReward);
 				}
 			}
 		}
 
-		engine_.HandleDeathEvent(entity_);
+		engine_.HandleDeathEvent(*entity);
 	}
 } // namespace tutorial
 
@@ -155,25 +169,30 @@ namespace tutorial
 
 	void BumpAction::Execute()
 	{
-		Action::Execute();
-
-		if (entity_.GetDestructible()->IsDead()) {
+		Entity* entity = GetEntity();
+		if (!entity || entity->GetDestructible()->IsDead()) {
 			return;
 		}
 
-		auto targetPos = entity_.GetPos() + pos_;
+		auto targetPos = entity->GetPos() + pos_;
 
 		// Execute the resolved action directly instead of queueing it
 		if (engine_.GetBlockingEntity(targetPos)) {
-			MeleeAction(engine_, entity_, pos_).Execute();
+			MeleeAction(engine_, *entity, pos_).Execute();
 		} else {
-			MoveAction(engine_, entity_, pos_).Execute();
+			MoveAction(engine_, *entity, pos_).Execute();
 		}
 	}
 } // namespace tutorial
 
 namespace tutorial
 {
+	inline namespace
+	{
+		// How far the sound of a fight carries
+		constexpr float kCombatNoiseRadius = 8.0f;
+	} // namespace
+
 	MeleeAction::MeleeAction(Engine& engine, Entity& entity, pos_t pos)
 	    : DirectionalAction(engine, entity, pos)
 	{
@@ -181,17 +200,16 @@ namespace tutorial
 
 	void MeleeAction::Execute()
 	{
-		Action::Execute();
-
-		if (!entity_.GetAttacker()) {
+		Entity* entity = GetEntity();
+		if (!entity || !entity->GetAttacker()) {
 			return;
 		}
 
-		auto targetPos = entity_.GetPos() + pos_;
+		auto targetPos = entity->GetPos() + pos_;
 		auto* target = engine_.GetBlockingEntity(targetPos);
 
 		if (target && !target->GetDestructible()->IsDead()) {
-			auto* attacker = entity_.GetAttacker();
+			auto* attacker = entity->GetAttacker();
 			auto* defender = target->GetDestructible();
 			auto damage =
 			    attacker->Attack() - defender->GetDefense();
@@ -200,7 +218,7 @@ namespace tutorial
 				auto msg = LocaleManager::Instance().GetMessage(
 				    "messages.combat.attack_hit",
 				    { { "attacker",
-				        util::capitalize(entity_.GetName()) },
+				        util::capitalize(entity->GetName()) },
 				      { "target", target->GetName() },
 				      { "damage", std::to_string(damage) } });
 				engine_.LogMessage(msg.text, msg.color,
@@ -211,11 +229,13 @@ namespace tutorial
 				auto msg = LocaleManager::Instance().GetMessage(
 				    "messages.combat.attack_miss",
 				    { { "attacker",
-				        util::capitalize(entity_.GetName()) },
+				        util::capitalize(entity->GetName()) },
 				      { "target", target->GetName() } });
 				engine_.LogMessage(msg.text, msg.color,
 				                   msg.stack);
 			}
+
+			engine_.MakeNoise(targetPos, kCombatNoiseRadius);
 		}
 	}
 } // namespace tutorial
@@ -229,13 +249,16 @@ namespace tutorial
 
 	void MoveAction::Execute()
 	{
-		Action::Execute();
+		Entity* entity = GetEntity();
+		if (!entity) {
+			return;
+		}
 
-		auto targetPos = entity_.GetPos() + pos_;
+		auto targetPos = entity->GetPos() + pos_;
 
 		if (engine_.IsInBounds(targetPos)
 		    && !engine_.IsWall(targetPos)) {
-			entity_.SetPos(entity_.GetPos() + pos_);
+			engine_.MoveEntity(*entity, targetPos);
 
 			// FOV computation handled by Engine::HandleEvents()
 			// post-processing This separates rendering concerns
@@ -253,21 +276,24 @@ namespace tutorial
 
 	void PickupAction::Execute()
 	{
-		Action::Execute();
+		Entity* entity = GetEntity();
+		if (!entity) {
+			return;
+		}
 
-		pos_t entityPos = entity_.GetPos();
+		pos_t entityPos = entity->GetPos();
 
 		// Collect all pickable items at this position
 		std::vector<Entity*> itemsHere;
 		const auto& entities = engine_.GetEntities();
 
-		for (const auto& actor : entities) {
+		for (auto* actor : entities) {
 			bool isPickableItem =
 			    actor->GetItem() && actor->GetPos() == entityPos
 			    && !actor->IsBlocker() && actor->IsPickable();
 
 			if (isPickableItem) {
-				itemsHere.push_back(actor.get());
+				itemsHere.push_back(actor);
 			}
 		}
 
@@ -280,7 +306,8 @@ namespace tutorial
 
 		// If only one item, pick it up directly
 		if (itemsHere.size() == 1) {
-			PickupItemAction(engine_, entity_, itemsHere[0])
+			PickupItemAction(engine_, *entity,
+			                 itemsHere[0]->GetHandle())
 			    .Execute();
 		} else {
 			// Multiple items - show selection menu
@@ -292,25 +319,24 @@ namespace tutorial
 namespace tutorial
 {
 	PickupItemAction::PickupItemAction(Engine& engine, Entity& entity,
-	                                   Entity* item)
+	                                   EntityHandle item)
 	    : Action(engine, entity), item_(item)
 	{
 	}
 
 	void PickupItemAction::Execute()
 	{
-		Action::Execute();
-
-		if (!item_) {
+		Entity* item = engine_.GetEntity(item_);
+		if (!item) {
 			return;
 		}
 
-		auto* player = dynamic_cast<Player*>(&entity_);
+		auto* player = dynamic_cast<Player*>(GetEntity());
 		if (!player) {
 			return;
 		}
 
-		std::string itemName = item_->GetName();
+		std::string itemName = item->GetName();
 		bool success =
 		    player->AddToInventory(engine_.RemoveEntity(item_));
 
@@ -340,9 +366,7 @@ namespace tutorial
 
 	void UseItemAction::Execute()
 	{
-		Action::Execute();
-
-		auto* player = dynamic_cast<Player*>(&entity_);
+		auto* player = dynamic_cast<Player*>(GetEntity());
 		if (!player) {
 			return;
 		}
@@ -395,10 +419,13 @@ namespace tutorial
 
 	void CastSpellAction::Execute()
 	{
-		Action::Execute();
+		Entity* entity = GetEntity();
+		if (!entity) {
+			return;
+		}
 
 		// Check if entity can cast spells
-		auto* caster = entity_.GetSpellcaster();
+		auto* caster = entity->GetSpellcaster();
 		if (!caster) {
 			return;
 		}
@@ -422,7 +449,7 @@ namespace tutorial
 		}
 
 		// Check if entity has enough MP
-		auto* destructible = entity_.GetDestructible();
+		auto* destructible = entity->GetDestructible();
 		if (!destructible) {
 			return;
 		}
@@ -441,7 +468,7 @@ namespace tutorial
 
 		// Select targets
 		std::vector<Entity*> targets;
-		if (!selector->SelectTargets(entity_, engine_, targets)) {
+		if (!selector->SelectTargets(*entity, engine_, targets)) {
 			return; // Targeting cancelled
 		}
 
@@ -522,9 +549,7 @@ namespace tutorial
 
 	void DropItemAction::Execute()
 	{
-		Action::Execute();
-
-		auto* player = dynamic_cast<Player*>(&entity_);
+		auto* player = dynamic_cast<Player*>(GetEntity());
 		if (!player) {
 			return;
 		}
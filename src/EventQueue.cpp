@@ -0,0 +1,81 @@
+#include "EventQueue.hpp"
+
+#include <utility>
+
+namespace tutorial
+{
+	inline namespace
+	{
+		// Enough for a player action and a crowded room of monsters
+		constexpr std::size_t kInitialCapacity = 64;
+	} // namespace
+
+	void Execute(ActionRecord& record)
+	{
+		// Every alternative is final, so the call is direct
+		std::visit([](auto& action) { action.Execute(); }, record);
+	}
+
+	EventQueue::EventQueue() : slots_(kInitialCapacity), allocations_(1)
+	{
+	}
+
+	void EventQueue::PushBack(ActionRecord record)
+	{
+		if (count_ == slots_.size()) {
+			Grow();
+		}
+
+		slots_[(head_ + count_) % slots_.size()].emplace(
+		    std::move(record));
+		++count_;
+	}
+
+	void EventQueue::PushFront(ActionRecord record)
+	{
+		if (count_ == slots_.size()) {
+			Grow();
+		}
+
+		head_ = (head_ + slots_.size() - 1) % slots_.size();
+		slots_[head_].emplace(std::move(record));
+		++count_;
+	}
+
+	ActionRecord EventQueue::PopFront()
+	{
+		auto& slot = slots_[head_];
+		ActionRecord record = std::move(*slot);
+		slot.reset();
+
+		head_ = (head_ + 1) % slots_.size();
+		--count_;
+
+		return record;
+	}
+
+	void EventQueue::Clear()
+	{
+		for (std::size_t i = 0; i < count_; ++i) {
+			slots_[(head_ + i) % slots_.size()].reset();
+		}
+
+		head_ = 0;
+		count_ = 0;
+	}
+
+	void EventQueue::Grow()
+	{
+		// Unwrap into a buffer twice the size, front at slot 0
+		std::vector<std::optional<ActionRecord>> grown(
+		    slots_.size() * 2);
+		for (std::size_t i = 0; i < count_; ++i) {
+			auto& slot = slots_[(head_ + i) % slots_.size()];
+			grown[i].emplace(std::move(*slot));
+		}
+
+		slots_.swap(grown);
+		head_ = 0;
+		++allocations_;
+	}
+} // namespace tutorial
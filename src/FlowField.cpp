@@ -0,0 +1,87 @@
+#include "FlowField.hpp"
+
+#include "Map.hpp"
+#include "Util.hpp"
+
+namespace tutorial
+{
+	inline namespace
+	{
+		constexpr pos_t kNeighbours[8] = {
+			{ 0, -1 }, { 1, 0 },  { 0, 1 },  { -1, 0 },
+			{ 1, -1 }, { 1, 1 },  { -1, 1 }, { -1, -1 }
+		};
+	} // namespace
+
+	bool FlowField::Update(const Map& map, pos_t goal)
+	{
+		bool stale = (map_ != &map
+		              || terrainVersion_ != map.GetTerrainVersion()
+		              || goal_ != goal);
+
+		if (!stale) {
+			return false;
+		}
+
+		map_ = &map;
+		terrainVersion_ = map.GetTerrainVersion();
+		goal_ = goal;
+		Rebuild(map);
+		return true;
+	}
+
+	std::uint16_t FlowField::GetDistance(pos_t pos) const
+	{
+		if (pos.x < 0 || pos.y < 0 || pos.x >= width_
+		    || pos.y >= height_) {
+			return kUnreachable;
+		}
+
+		return distances_[util::posToIndex(pos, width_)];
+	}
+
+	void FlowField::Rebuild(const Map& map)
+	{
+		width_ = map.GetWidth();
+		height_ = map.GetHeight();
+		distances_.assign(width_ * height_, kUnreachable);
+		frontier_.clear();
+
+		if (!map.IsInBounds(goal_) || map.IsWall(goal_)) {
+			return;
+		}
+
+		// Uniform step costs, so breadth-first order is Dijkstra order
+		// and the frontier vector doubles as the queue
+		int goalIndex = util::posToIndex(goal_, width_);
+		distances_[goalIndex] = 0;
+		frontier_.push_back(goalIndex);
+
+		for (std::size_t head = 0; head < frontier_.size(); ++head) {
+			int index = frontier_[head];
+			pos_t pos = util::indexToPos(index, width_);
+			std::uint16_t next = distances_[index] + 1;
+
+			if (next == kUnreachable) {
+				continue;
+			}
+
+			for (pos_t dir : kNeighbours) {
+				pos_t neighbour = pos + dir;
+				if (!map.IsInBounds(neighbour)) {
+					continue;
+				}
+
+				int neighbourIndex =
+				    util::posToIndex(neighbour, width_);
+				if (distances_[neighbourIndex] != kUnreachable
+				    || !map.IsWalkableAt(neighbourIndex)) {
+					continue;
+				}
+
+				distances_[neighbourIndex] = next;
+				frontier_.push_back(neighbourIndex);
+			}
+		}
+	}
+} // namespace tutorial
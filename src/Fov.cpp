@@ -0,0 +1,242 @@
+#include "Fov.hpp"
+
+#include "Util.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace tutorial
+{
+	inline namespace
+	{
+		// Slopes are kept as exact fractions so row bounds never drift
+		struct Slope {
+			int num;
+			int den; // Always positive
+		};
+
+		int FloorDiv(int a, int b)
+		{
+			int q = a / b;
+			return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+		}
+
+		int CeilDiv(int a, int b)
+		{
+			return -FloorDiv(-a, b);
+		}
+
+		// One row of a quadrant, depth tiles out from the origin
+		struct Row {
+			int depth;
+			Slope start;
+			Slope end;
+
+			// Round depth*start + 1/2 down (ties toward the end)
+			int MinCol() const
+			{
+				return FloorDiv(
+				    2 * depth * start.num + start.den,
+				    2 * start.den);
+			}
+
+			// Round depth*end - 1/2 up (ties toward the start)
+			int MaxCol() const
+			{
+				return CeilDiv(2 * depth * end.num - end.den,
+				               2 * end.den);
+			}
+
+			// Centre of the tile lies inside the row's wedge
+			bool IsSymmetric(int col) const
+			{
+				return col * start.den >= depth * start.num
+				       && col * end.den <= depth * end.num;
+			}
+		};
+
+		Slope TileSlope(int depth, int col)
+		{
+			return Slope { 2 * col - 1, 2 * depth };
+		}
+
+		class QuadrantScanner
+		{
+		public:
+			QuadrantScanner(const BitGrid& transparent, int width,
+			                int height, pos_t origin, int radius,
+			                BitGrid& visible, pos_t windowOrigin,
+			                pos_t windowSize)
+			    : transparent_(transparent),
+			      visible_(visible),
+			      windowOrigin_(windowOrigin),
+			      windowSize_(windowSize),
+			      width_(width),
+			      height_(height),
+			      origin_(origin),
+			      radius_(radius),
+			      maxDepth_(radius > 0 ? radius
+			                           : std::max(width, height))
+			{
+			}
+
+			void Scan(int quadrant)
+			{
+				quadrant_ = quadrant;
+				rows_.clear();
+				rows_.push_back(Row { 1, { -1, 1 }, { 1, 1 } });
+
+				while (!rows_.empty()) {
+					Row row = rows_.back();
+					rows_.pop_back();
+					ScanRow(row);
+				}
+			}
+
+			void RevealOrigin()
+			{
+				Reveal(origin_, 0, 0);
+			}
+
+		private:
+			// Map (depth, col) in the current quadrant to the grid
+			pos_t Transform(int depth, int col) const
+			{
+				switch (quadrant_) {
+					case 0: // North
+						return { origin_.x + col,
+							 origin_.y - depth };
+					case 1: // East
+						return { origin_.x + depth,
+							 origin_.y + col };
+					case 2: // South
+						return { origin_.x + col,
+							 origin_.y + depth };
+					default: // West
+						return { origin_.x - depth,
+							 origin_.y + col };
+				}
+			}
+
+			bool InBounds(pos_t pos) const
+			{
+				return pos.x >= 0 && pos.y >= 0
+				       && pos.x < width_ && pos.y < height_;
+			}
+
+			// Off-map tiles behave as unlit walls
+			bool IsOpaque(pos_t pos) const
+			{
+				return !InBounds(pos)
+				       || !transparent_.Get(
+				           util::posToIndex(pos, width_));
+			}
+
+			void Reveal(pos_t pos, int depth, int col)
+			{
+				pos_t local { pos.x - windowOrigin_.x,
+					      pos.y - windowOrigin_.y };
+				if (!InBounds(pos) || local.x < 0 || local.y < 0
+				    || local.x >= windowSize_.x
+				    || local.y >= windowSize_.y) {
+					return;
+				}
+
+				if (radius_ > 0
+				    && depth * depth + col * col
+				           > radius_ * radius_) {
+					return;
+				}
+
+				visible_.Set(
+				    util::posToIndex(local, windowSize_.x),
+				    true);
+			}
+
+			void ScanRow(Row row)
+			{
+				if (row.depth > maxDepth_) {
+					return;
+				}
+
+				int minCol = row.MinCol();
+				int maxCol = row.MaxCol();
+
+				// 0 = no previous tile, 1 = floor, 2 = wall
+				int prev = 0;
+
+				for (int col = minCol; col <= maxCol; ++col) {
+					pos_t pos = Transform(row.depth, col);
+					bool opaque = IsOpaque(pos);
+
+					if (opaque || row.IsSymmetric(col)) {
+						Reveal(pos, row.depth, col);
+					}
+
+					if (prev == 2 && !opaque) {
+						row.start =
+						    TileSlope(row.depth, col);
+					}
+
+					if (prev == 1 && opaque) {
+						Slope end =
+						    TileSlope(row.depth, col);
+						rows_.push_back(Row {
+						    row.depth + 1, row.start,
+						    end });
+					}
+
+					prev = opaque ? 2 : 1;
+				}
+
+				if (prev == 1) {
+					rows_.push_back(Row { row.depth + 1,
+							      row.start,
+							      row.end });
+				}
+			}
+
+			const BitGrid& transparent_;
+			BitGrid& visible_;
+			pos_t windowOrigin_;
+			pos_t windowSize_;
+			int width_;
+			int height_;
+			pos_t origin_;
+			int radius_;
+			int maxDepth_;
+			int quadrant_ = 0;
+			std::vector<Row> rows_;
+		};
+	} // namespace
+
+	void ComputeShadowcastFov(const BitGrid& transparent, int width,
+	                          int height, pos_t origin, int radius,
+	                          BitGrid& visible)
+	{
+		ComputeShadowcastFov(transparent, width, height, origin, radius,
+		                     visible, pos_t { 0, 0 },
+		                     pos_t { width, height });
+	}
+
+	void ComputeShadowcastFov(const BitGrid& transparent, int width,
+	                          int height, pos_t origin, int radius,
+	                          BitGrid& visible, pos_t windowOrigin,
+	                          pos_t windowSize)
+	{
+		if (origin.x < 0 || origin.y < 0 || origin.x >= width
+		    || origin.y >= height) {
+			return;
+		}
+
+		QuadrantScanner scanner(transparent, width, height, origin,
+		                        radius, visible, windowOrigin,
+		                        windowSize);
+
+		// The origin is depth 0 of every quadrant, so reveal it once
+		scanner.RevealOrigin();
+		for (int quadrant = 0; quadrant < 4; ++quadrant) {
+			scanner.Scan(quadrant);
+		}
+	}
+} // namespace tutorial
@@ -3,13 +3,18 @@
 #include "Colors.hpp"
 #include "ConfigManager.hpp"
 #include "Entity.hpp"
+#include "EntityManager.hpp"
 
 namespace tutorial
 {
 	ItemSelectionWindow::ItemSelectionWindow(
 	    std::size_t width, std::size_t height, pos_t pos,
-	    const std::vector<Entity*>& items, const std::string& title)
-	    : UiWindowBase(width, height, pos), items_(items), title_(title)
+	    const EntityManager& entities,
+	    const std::vector<EntityHandle>& items, const std::string& title)
+	    : UiWindowBase(width, height, pos),
+	      entities_(entities),
+	      items_(items),
+	      title_(title)
 	{
 	}
 
@@ -43,7 +48,16 @@ namespace tutorial
 		char shortcut = 'a';
 		int y = 1;
 
-		for (const auto* item : items_) {
+		for (EntityHandle handle : items_) {
+			// Keep shortcuts aligned with list indices even if an
+			// entry has gone stale
+			const Entity* item = entities_.Get(handle);
+			if (!item) {
+				y++;
+				shortcut++;
+				continue;
+			}
+
 			TCOD_printf_rgb(
 			    console_,
 			    (TCOD_PrintParamsRGB) { .x = 2,
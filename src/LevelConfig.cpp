@@ -120,4 +120,30 @@ namespace tutorial
 		return config;
 	}
 
+	LevelConfig LevelConfig::LoadForDepth(int dungeonLevel)
+	{
+		std::string levelConfigPath;
+
+		if (dungeonLevel == 1) {
+			levelConfigPath = "data/levels/dungeon_1.json";
+		} else if (dungeonLevel == 2) {
+			levelConfigPath = "data/levels/dungeon_2.json";
+		} else {
+			levelConfigPath = "data/levels/dungeon_2.json";
+		}
+
+		try {
+			LevelConfig config = LoadFromFile(levelConfigPath);
+			std::cout << "[LevelConfig] Loaded level config: "
+			          << config.id << std::endl;
+			return config;
+		} catch (const std::exception& e) {
+			std::cerr << "[LevelConfig] Failed to load level "
+			             "config: "
+			          << e.what() << ", using dungeon_1"
+			          << std::endl;
+			return LoadFromFile("data/levels/dungeon_1.json");
+		}
+	}
+
 } // namespace tutorial
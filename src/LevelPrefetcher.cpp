@@ -0,0 +1,129 @@
+#include "LevelPrefetcher.hpp"
+
+#include "BasicDungeonGenerator.hpp"
+#include "DynamicSpawnSystem.hpp"
+#include "EntityManager.hpp"
+#include "Map.hpp"
+#include "Random.hpp"
+#include "TemplateRegistry.hpp"
+
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace tutorial
+{
+	LevelPrefetcher::~LevelPrefetcher()
+	{
+		Cancel();
+	}
+
+	void LevelPrefetcher::Start(int dungeonLevel, std::uint64_t masterSeed,
+	                            pos_t mapSize,
+	                            const ScentField::Config& scentConfig)
+	{
+		Cancel();
+
+		// Both log what they load, so keep them off the worker
+		LevelConfig config;
+		auto spawns = std::make_unique<DynamicSpawnSystem>();
+		try {
+			config = LevelConfig::LoadForDepth(dungeonLevel);
+			spawns->BuildSpawnTablesForLevel(config);
+		} catch (const std::exception& e) {
+			std::cerr << "[LevelPrefetcher] Failed to load level "
+			          << dungeonLevel << ": " << e.what()
+			          << std::endl;
+			return;
+		}
+
+		pendingLevel_ = dungeonLevel;
+		pending_ = std::async(
+		    std::launch::async,
+		    [=, config = std::move(config),
+		     spawns = std::move(spawns)]() mutable {
+			    return Build(dungeonLevel, std::move(config),
+			                 *spawns, masterSeed, mapSize,
+			                 scentConfig);
+		    });
+	}
+
+	std::unique_ptr<PreparedLevel> LevelPrefetcher::Take(int dungeonLevel)
+	{
+		if (!pending_.valid()) {
+			return nullptr;
+		}
+
+		if (pendingLevel_ != dungeonLevel) {
+			Cancel();
+			return nullptr;
+		}
+
+		try {
+			return pending_.get();
+		} catch (const std::exception& e) {
+			std::cerr << "[LevelPrefetcher] Failed to build level "
+			          << dungeonLevel << ": " << e.what()
+			          << std::endl;
+			return nullptr;
+		}
+	}
+
+	void LevelPrefetcher::Cancel()
+	{
+		if (pending_.valid()) {
+			// Generation cannot be interrupted; wait it out and
+			// discard the result, including any exception
+			pending_.wait();
+			pending_ = {};
+		}
+	}
+
+	std::unique_ptr<PreparedLevel> LevelPrefetcher::Build(
+	    int dungeonLevel, LevelConfig config,
+	    const DynamicSpawnSystem& spawns, std::uint64_t masterSeed,
+	    pos_t mapSize, const ScentField::Config& scentConfig)
+	{
+		ScopedLevelRandom levelRandom(masterSeed, dungeonLevel);
+
+		auto level = std::make_unique<PreparedLevel>();
+		level->dungeonLevel = dungeonLevel;
+		level->config = std::move(config);
+
+		level->map = std::make_unique<Map>(mapSize.x, mapSize.y);
+		level->map->SetScentConfig(scentConfig);
+		GenerateMap(*level->map, level->config);
+
+		const auto& rooms = level->map->GetRooms();
+		if (rooms.empty()) {
+			return level;
+		}
+
+		EntityManager planner;
+		planner.Resize(mapSize.x, mapSize.y);
+		level->entities = planner.RollRooms(rooms.begin() + 1,
+		                                    rooms.end(), level->config,
+		                                    spawns);
+
+		level->stairs = TemplateRegistry::Instance().Create(
+		    "stairs_down", rooms.back().GetCenter());
+
+		return level;
+	}
+
+	void LevelPrefetcher::GenerateMap(Map& map, const LevelConfig& level)
+	{
+		// Use DCSS-style basic dungeon generator
+		auto config = BasicDungeonGenerator::GetDefaultConfig(
+		    level.generation.width, level.generation.height);
+
+		// Override with level-specific settings if desired
+		config.maxRooms = level.generation.maxRooms;
+		config.minRoomSize = level.generation.minRoomSize;
+		config.maxRoomSize = level.generation.maxRoomSize;
+
+		BasicDungeonGenerator generator(config);
+		map.Generate(generator);
+		map.Update();
+	}
+} // namespace tutorial
@@ -0,0 +1,116 @@
+#include "LineOfSight.hpp"
+
+#include "Map.hpp"
+#include "Util.hpp"
+
+#include <libtcod/bresenham.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace tutorial
+{
+	void LineOfSight::Reserve(int range)
+	{
+		if (range <= range_) {
+			return;
+		}
+
+		int side = 2 * range + 1;
+		offsets_.assign(side * side + 1, 0);
+		steps_.clear();
+
+		// Bresenham is translation invariant, so the line from (0, 0)
+		// to (dx, dy) shifted by the origin is the line a query would
+		// have drawn
+		for (int dy = -range; dy <= range; ++dy) {
+			for (int dx = -range; dx <= range; ++dx) {
+				offsets_[util::posToIndex(
+				    pos_t { dx + range, dy + range }, side)] =
+				    static_cast<std::uint32_t>(steps_.size());
+
+				tcod::BresenhamLine line({ 0, 0 }, { dx, dy });
+				for (auto it = line.begin(); it != line.end();
+				     ++it) {
+					auto [x, y] = *it;
+					if (x == 0 && y == 0) {
+						continue;
+					}
+					steps_.push_back(pos_t { x, y });
+				}
+			}
+		}
+		offsets_.back() = static_cast<std::uint32_t>(steps_.size());
+
+		range_ = range;
+	}
+
+	LineOfSight::Ray LineOfSight::GetRay(pos_t delta)
+	{
+		Reserve(std::max(std::abs(delta.x), std::abs(delta.y)));
+
+		int side = 2 * range_ + 1;
+		std::size_t index = util::posToIndex(
+		    pos_t { delta.x + range_, delta.y + range_ }, side);
+
+		return { steps_.data() + offsets_[index],
+			 steps_.data() + offsets_[index + 1] };
+	}
+
+	bool LineOfSight::HasLineOfSight(const Map& map, pos_t origin,
+	                                 pos_t target)
+	{
+		// Any terrain change can open or close any line
+		if (map_ != &map || terrainVersion_ != map.GetTerrainVersion()
+		    || cache_.size() >= kMaxCachedQueries) {
+			cache_.clear();
+			map_ = &map;
+			terrainVersion_ = map.GetTerrainVersion();
+		}
+
+		pos_t delta { target.x - origin.x, target.y - origin.y };
+		if (!map.IsInBounds(origin) || !map.IsInBounds(target)) {
+			return Trace(map, origin, delta);
+		}
+
+		auto area = static_cast<std::uint64_t>(map.GetWidth())
+		            * static_cast<std::uint64_t>(map.GetHeight());
+		std::uint64_t key =
+		    static_cast<std::uint64_t>(
+		        util::posToIndex(origin, map.GetWidth()))
+		        * area
+		    + static_cast<std::uint64_t>(
+		        util::posToIndex(target, map.GetWidth()));
+
+		auto cached = cache_.find(key);
+		if (cached != cache_.end()) {
+			return cached->second;
+		}
+
+		bool visible = Trace(map, origin, delta);
+		cache_.emplace(key, visible);
+		return visible;
+	}
+
+	bool LineOfSight::Trace(const Map& map, pos_t origin, pos_t delta)
+	{
+		auto [first, last] = GetRay(delta);
+
+		// The last step is the target itself, which may be opaque
+		for (auto* step = first; step != last && step + 1 != last;
+		     ++step) {
+			pos_t tile { origin.x + step->x, origin.y + step->y };
+			if (!map.IsTransparent(tile)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void LineOfSight::Clear()
+	{
+		cache_.clear();
+		map_ = nullptr;
+	}
+} // namespace tutorial
@@ -1,26 +1,47 @@
 #include "Map.hpp"
 
-#include "AiComponent.hpp"
 #include "Colors.hpp"
 #include "Entity.hpp"
 #include "EntityManager.hpp"
 #include "MapGenerator.hpp"
 #include "Util.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
 
 namespace tutorial
 {
+	inline namespace
+	{
+		// Versions are unique across every Map, so a cache keyed on
+		// the version alone cannot confuse a map with its successor
+		unsigned int NextTerrainVersion()
+		{
+			static std::atomic<unsigned int> counter { 0 };
+			return ++counter;
+		}
+	} // namespace
+
 	Map::Map(int width, int height)
-	    : tiles_(std::vector<tile_t>(width * height,
-	                                 tile_t { TileType::WALL, false })),
+	    : walkable_(width * height, false),
+	      transparent_(width * height, false),
+	      explored_(width * height, false),
+	      inFov_(width * height, false),
 	      console_(nullptr),
 	      map_(nullptr),
 	      width_(width),
 	      height_(height),
-	      currentScentValue_(SCENT_THRESHOLD)
+	      terrainVersion_(NextTerrainVersion()),
+	      fovBoxMin_ { 0, 0 },
+	      fovBoxMax_ { -1, -1 },
+	      fovScratch_(width * height, false),
+	      isDirty_(width * height, false),
+	      fullRepaint_(true)
 	{
+		scent_.Resize(width, height);
+
 		// Create console using C API instead of C++ wrapper
 		console_ = TCOD_console_new(width, height);
 		if (!console_) {
@@ -47,11 +68,74 @@ namespace tutorial
 		}
 	}
 
-	void Map::ComputeFov(pos_t origin, int fovRadius)
+	void Map::ComputeFov(pos_t origin, int fovRadius,
+	                     FovAlgorithm algorithm)
 	{
-		// Modern C API for FOV computation
-		TCOD_map_compute_fov(map_, origin.x, origin.y, fovRadius, true,
-		                     FOV_RESTRICTIVE);
+		// Only the radius box can be lit; 0 means unlimited
+		int minX = 0;
+		int minY = 0;
+		int maxX = width_ - 1;
+		int maxY = height_ - 1;
+
+		if (fovRadius > 0) {
+			minX = std::max(minX, origin.x - fovRadius);
+			minY = std::max(minY, origin.y - fovRadius);
+			maxX = std::min(maxX, origin.x + fovRadius);
+			maxY = std::min(maxY, origin.y + fovRadius);
+		}
+
+		fovBoxMin_ = pos_t { minX, minY };
+		fovBoxMax_ = pos_t { maxX, maxY };
+
+		// Compute the new FOV into the scratch plane
+		if (algorithm == FovAlgorithm::Shadowcast) {
+			ComputeShadowcastFov(transparent_, width_, height_,
+			                     origin, fovRadius, fovScratch_);
+		} else {
+			// Modern C API for FOV computation
+			TCOD_map_compute_fov(map_, origin.x, origin.y,
+			                     fovRadius, true, FOV_RESTRICTIVE);
+			for (int y = minY; y <= maxY; ++y) {
+				int row = y * width_;
+				for (int x = minX; x <= maxX; ++x) {
+					if (TCOD_map_is_in_fov(map_, x, y)) {
+						fovScratch_.Set(row + x, true);
+					}
+				}
+			}
+		}
+
+		// Tiles that dropped out of view
+		for (int index : visible_) {
+			if (!fovScratch_.Get(index)) {
+				inFov_.Set(index, false);
+				MarkDirty(index);
+			}
+		}
+
+		// Tiles that came into view. Clearing scratch bits as they are
+		// consumed leaves the plane empty for the next call.
+		visible_.clear();
+		for (int y = minY; y <= maxY; ++y) {
+			for (int x = minX; x <= maxX; ++x) {
+				int index =
+				    util::posToIndex(pos_t { x, y }, width_);
+				if (!fovScratch_.Get(index)) {
+					continue;
+				}
+
+				fovScratch_.Set(index, false);
+				visible_.push_back(index);
+
+				if (!inFov_.Get(index)) {
+					inFov_.Set(index, true);
+					MarkDirty(index);
+				}
+			}
+		}
+
+		// Everything in view is now explored
+		explored_.OrWith(inFov_);
 	}
 
 	void Map::Generate(Generator& generator)
@@ -62,70 +146,108 @@ namespace tutorial
 
 	void Map::SetExplored(pos_t pos, bool explored)
 	{
-		tiles_.at(util::posToIndex(pos, width_)).explored = explored;
+		int index = util::posToIndex(pos, width_);
+		explored_.Set(index, explored);
+		MarkDirty(index);
 	}
 
 	void Map::SetTileType(pos_t pos, TileType type)
 	{
-		tiles_.at(util::posToIndex(pos, width_)).type = type;
+		int index = util::posToIndex(pos, width_);
+		bool wasWalkable = walkable_.Get(index);
+		terrainVersion_ = NextTerrainVersion();
+		MarkDirty(index);
 
 		switch (type) {
 			case TileType::FLOOR:
 				// transparent = true, walkable = true
+				walkable_.Set(index, true);
+				transparent_.Set(index, true);
 				TCOD_map_set_properties(map_, pos.x, pos.y,
 				                        true, true);
 				break;
 			case TileType::WALL:
 				// transparent = false, walkable = false
+				walkable_.Set(index, false);
+				transparent_.Set(index, false);
 				TCOD_map_set_properties(map_, pos.x, pos.y,
 				                        false, false);
 				break;
 			default:
 				break;
 		}
+
+		// An unbuilt graph will see the change when it is built
+		if (walkable_.Get(index) != wasWalkable
+		    && navGraph_.IsBuilt()) {
+			navGraphPending_.push_back(pos);
+		}
 	}
 
-	void Map::Update()
+	const NavGraph& Map::GetNavGraph() const
 	{
-		// Clear console using C API
-		TCOD_console_clear(console_);
+		std::lock_guard<std::mutex> lock(navGraphMutex_);
 
-		for (std::size_t i = 0; i < tiles_.size(); ++i) {
-			const auto pos = util::indexToPos(i, width_);
+		if (!navGraph_.IsBuilt()) {
+			navGraph_.Build(walkable_, width_, height_);
+			navGraphPending_.clear();
+		}
 
-			tcod::ColorRGB color { 0, 0, 0 }; // Default black
-			auto& tile = tiles_.at(i);
+		for (pos_t pos : navGraphPending_) {
+			navGraph_.OnTileChanged(walkable_, pos);
+		}
+		navGraphPending_.clear();
 
-			if (IsInFov(pos)) {
-				tile.explored = true;
+		return navGraph_;
+	}
 
-				switch (tile.type) {
-					case TileType::FLOOR:
-						color = color::light_amber;
-						break;
-					case TileType::WALL:
-						color = color::dark_amber;
-						break;
-					default:
-						break;
-				}
-			} else if (IsExplored(pos)) {
-				switch (tile.type) {
-					case TileType::FLOOR:
-						color = color::light_azure;
-						break;
-					case TileType::WALL:
-						color = color::dark_azure;
-						break;
-					default:
-						break;
-				}
+	void Map::Update()
+	{
+		if (fullRepaint_) {
+			// Clear console using C API
+			TCOD_console_clear(console_);
+
+			for (int i = 0; i < width_ * height_; ++i) {
+				PaintTile(i);
+			}
+
+			fullRepaint_ = false;
+		} else {
+			for (int index : dirty_) {
+				PaintTile(index);
 			}
+		}
+
+		for (int index : dirty_) {
+			isDirty_.Set(index, false);
+		}
+		dirty_.clear();
+	}
+
+	void Map::MarkDirty(int index)
+	{
+		if (!isDirty_.Get(index)) {
+			isDirty_.Set(index, true);
+			dirty_.push_back(index);
+		}
+	}
+
+	void Map::PaintTile(int index)
+	{
+		const auto pos = util::indexToPos(index, width_);
+		const bool floor = walkable_.Get(index);
 
-			// Set background color (0 = don't change character)
-			TCOD_console_put_rgb(console_, pos.x, pos.y, 0, NULL,
-			                     &color, TCOD_BKGND_SET);
+		tcod::ColorRGB color { 0, 0, 0 }; // Default black
+
+		if (inFov_.Get(index)) {
+			color = floor ? color::light_amber : color::dark_amber;
+		} else if (explored_.Get(index)) {
+			color = floor ? color::light_azure : color::dark_azure;
 		}
+
+		// Set background color (0 = don't change character)
+		TCOD_console_put_rgb(console_, pos.x, pos.y, 0, NULL, &color,
+		                     TCOD_BKGND_SET);
 	}
 
 	int Map::GetHeight() const
@@ -140,7 +262,10 @@ namespace tutorial
 
 	TileType Map::GetTileType(pos_t pos) const
 	{
-		return tiles_.at(util::posToIndex(pos, width_)).type;
+		// Only floor and wall are ever stored
+		return walkable_.Get(util::posToIndex(pos, width_))
+		           ? TileType::FLOOR
+		           : TileType::WALL;
 	}
 
 	int Map::GetWidth() const
@@ -156,25 +281,27 @@ namespace tutorial
 
 	bool Map::IsExplored(pos_t pos) const
 	{
-		return tiles_.at(util::posToIndex(pos, width_)).explored;
+		return IsInBounds(pos)
+		       && explored_.Get(util::posToIndex(pos, width_));
 	}
 
 	bool Map::IsInFov(pos_t pos) const
 	{
-		// Use C API to check FOV
-		return TCOD_map_is_in_fov(map_, pos.x, pos.y);
+		return IsInBounds(pos)
+		       && inFov_.Get(util::posToIndex(pos, width_));
 	}
 
 	bool Map::IsWall(pos_t pos) const
 	{
-		// Use C API to check if walkable (walls are not walkable)
-		return !TCOD_map_is_walkable(map_, pos.x, pos.y);
+		// Out of bounds counts as wall
+		return !IsInBounds(pos)
+		       || !walkable_.Get(util::posToIndex(pos, width_));
 	}
 
 	bool Map::IsTransparent(pos_t pos) const
 	{
-		// Use C API to check if transparent (walls block sight)
-		return TCOD_map_is_transparent(map_, pos.x, pos.y);
+		return IsInBounds(pos)
+		       && transparent_.Get(util::posToIndex(pos, width_));
 	}
 
 	void Map::Render(TCOD_Console* parent) const
@@ -188,57 +315,39 @@ namespace tutorial
 	void Map::Clear()
 	{
 		rooms_.clear();
+		navGraph_.Reset();
+		navGraphPending_.clear();
+		terrainVersion_ = NextTerrainVersion();
 		TCOD_map_clear(
 		    map_, false,
 		    false); // Set all tiles to non-transparent, non-walkable
 
-		for (auto& tile : tiles_) {
-			tile.explored = false;
-			tile.type = TileType::WALL;
-		}
+		walkable_.Fill(false);
+		transparent_.Fill(false);
+		explored_.Fill(false);
+
+		// TCOD_map_clear also drops the FOV, so start the diff afresh
+		visible_.clear();
+		dirty_.clear();
+		inFov_.Fill(false);
+		isDirty_.Fill(false);
+		fullRepaint_ = true;
 	}
 
 	void Map::UpdateScent(pos_t playerPos)
 	{
-		// Increment scent value each turn
-		currentScentValue_++;
-
-		// Update scent in all visible tiles based on distance to player
-		for (int x = 0; x < width_; ++x) {
-			for (int y = 0; y < height_; ++y) {
-				pos_t pos { x, y };
-				if (IsInFov(pos)) {
-					auto& tile = tiles_.at(
-					    util::posToIndex(pos, width_));
-					unsigned int oldScent = tile.scent;
-
-					// Calculate Manhattan distance to
-					// player
-					int dx = std::abs(x - playerPos.x);
-					int dy = std::abs(y - playerPos.y);
-					int distance = dx + dy;
-
-					// New scent = current turn value minus
-					// distance
-					unsigned int newScent =
-					    currentScentValue_ - distance;
-
-					// Only update if new scent is stronger
-					// than old
-					if (newScent > oldScent) {
-						tile.scent = newScent;
-					}
-				}
-			}
+		// Only the last FOV box can have changed
+		scent_.Deposit(inFov_, fovBoxMin_, fovBoxMax_, playerPos);
+
+		if (scent_.GetConfig().diffusion) {
+			scent_.Diffuse(walkable_, fovBoxMin_, fovBoxMax_,
+			               scent_.GetConfig().diffusionRange);
 		}
 	}
 
 	unsigned int Map::GetScent(pos_t pos) const
 	{
-		if (!IsInBounds(pos)) {
-			return 0;
-		}
-		return tiles_.at(util::posToIndex(pos, width_)).scent;
+		return scent_.Get(pos);
 	}
 
 	void Map::AddRoom(const Room& room)
@@ -104,7 +104,7 @@ namespace tutorial
 
 				// Keep reference for plural name
 				if (entityRefs.find(name) == entityRefs.end()) {
-					entityRefs[name] = entity.get();
+					entityRefs[name] = entity;
 				}
 			}
 		}
@@ -0,0 +1,481 @@
+#include "NavGraph.hpp"
+
+#include "PathFinding.hpp"
+#include "Util.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace tutorial
+{
+	inline namespace
+	{
+		constexpr pos_t kAllDirs[8] = {
+			{ 0, -1 }, { 1, 0 },  { 0, 1 },  { -1, 0 },
+			{ 1, -1 }, { 1, 1 },  { -1, 1 }, { -1, -1 }
+		};
+
+		constexpr int kStraightCost = 10;
+		constexpr int kDiagonalCost = 14;
+
+		// Border runs at least this long get an entrance at each end
+		// instead of one in the middle, as in the HPA* paper
+		constexpr int kDoubleEntranceRun = 6;
+
+		using OpenNode = PathfindingContext::Node;
+
+		const auto kHeapCompare = std::greater<OpenNode> {};
+
+		// Index of pos within the inclusive rectangle [min, max]
+		int LocalIndex(pos_t pos, pos_t min, pos_t max)
+		{
+			return util::posToIndex(pos - min, max.x - min.x + 1);
+		}
+
+		int OctileDistance(pos_t a, pos_t b)
+		{
+			int dx = std::abs(a.x - b.x);
+			int dy = std::abs(a.y - b.y);
+			return kStraightCost * std::max(dx, dy)
+			       + (kDiagonalCost - kStraightCost)
+			             * std::min(dx, dy);
+		}
+	} // namespace
+
+	void NavGraph::Build(const BitGrid& walkable, int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+		clustersWide_ = (width + kClusterSize - 1) / kClusterSize;
+		clustersHigh_ = (height + kClusterSize - 1) / kClusterSize;
+
+		clusters_.assign(clustersWide_ * clustersHigh_, {});
+		nodeAt_.assign(width * height, -1);
+
+		for (int cy = 0; cy < clustersHigh_; ++cy) {
+			for (int cx = 0; cx < clustersWide_; ++cx) {
+				BuildCluster(walkable, cx, cy);
+			}
+		}
+
+		built_ = true;
+	}
+
+	void NavGraph::OnTileChanged(const BitGrid& walkable, pos_t pos)
+	{
+		if (!built_) {
+			return;
+		}
+
+		int cx = pos.x / kClusterSize;
+		int cy = pos.y / kClusterSize;
+		pos_t min, max;
+		GetClusterBounds(pos, min, max);
+
+		BuildCluster(walkable, cx, cy);
+
+		// Border tiles decide the entrances on both sides
+		if (pos.x == min.x && cx > 0) {
+			BuildCluster(walkable, cx - 1, cy);
+		}
+		if (pos.x == max.x && cx + 1 < clustersWide_) {
+			BuildCluster(walkable, cx + 1, cy);
+		}
+		if (pos.y == min.y && cy > 0) {
+			BuildCluster(walkable, cx, cy - 1);
+		}
+		if (pos.y == max.y && cy + 1 < clustersHigh_) {
+			BuildCluster(walkable, cx, cy + 1);
+		}
+	}
+
+	void NavGraph::Reset()
+	{
+		clusters_.clear();
+		nodeAt_.clear();
+		built_ = false;
+	}
+
+	void NavGraph::GetClusterBounds(pos_t pos, pos_t& min, pos_t& max) const
+	{
+		min = pos_t { (pos.x / kClusterSize) * kClusterSize,
+			      (pos.y / kClusterSize) * kClusterSize };
+		max = pos_t { std::min(min.x + kClusterSize, width_) - 1,
+			      std::min(min.y + kClusterSize, height_) - 1 };
+	}
+
+	std::size_t NavGraph::GetNodeCount() const
+	{
+		std::size_t count = 0;
+		for (const auto& cluster : clusters_) {
+			count += cluster.nodes.size();
+		}
+		return count;
+	}
+
+	int NavGraph::ClusterIndex(pos_t pos) const
+	{
+		return util::posToIndex(
+		    pos_t { pos.x / kClusterSize, pos.y / kClusterSize },
+		    clustersWide_);
+	}
+
+	void NavGraph::CollectTransitions(const BitGrid& walkable, int cx,
+	                                  int cy, bool east,
+	                                  Transitions& out) const
+	{
+		// Walk the border between this cluster and its east or south
+		// neighbour; 'inner' is our side, 'outer' theirs
+		int length = 0;
+		pos_t first, step, across;
+
+		if (east) {
+			first = pos_t { (cx + 1) * kClusterSize - 1,
+				        cy * kClusterSize };
+			step = pos_t { 0, 1 };
+			across = pos_t { 1, 0 };
+			length = std::min(kClusterSize, height_ - first.y);
+		} else {
+			first = pos_t { cx * kClusterSize,
+				        (cy + 1) * kClusterSize - 1 };
+			step = pos_t { 1, 0 };
+			across = pos_t { 0, 1 };
+			length = std::min(kClusterSize, width_ - first.x);
+		}
+
+		auto inner = [&](int i) {
+			return pos_t { first.x + step.x * i,
+				       first.y + step.y * i };
+		};
+
+		auto open = [&](int i) {
+			return walkable.Get(util::posToIndex(inner(i), width_))
+			       && walkable.Get(util::posToIndex(
+			           inner(i) + across, width_));
+		};
+
+		auto emit = [&](int i) {
+			out.emplace_back(
+			    util::posToIndex(inner(i), width_),
+			    util::posToIndex(inner(i) + across, width_));
+		};
+
+		for (int i = 0; i < length;) {
+			if (!open(i)) {
+				++i;
+				continue;
+			}
+
+			int runStart = i;
+			while (i < length && open(i)) {
+				++i;
+			}
+			int runLength = i - runStart;
+
+			if (runLength >= kDoubleEntranceRun) {
+				emit(runStart);
+				emit(i - 1);
+			} else {
+				emit(runStart + runLength / 2);
+			}
+		}
+	}
+
+	void NavGraph::ClusterDistances(const BitGrid& walkable, pos_t origin,
+	                                std::vector<int>& distances) const
+	{
+		pos_t min, max;
+		GetClusterBounds(origin, min, max);
+		int localWidth = max.x - min.x + 1;
+		int localHeight = max.y - min.y + 1;
+
+		distances.assign(localWidth * localHeight, -1);
+
+		// Copy the cluster into a grid padded with a ring of walls, so
+		// the search below needs no bounds checks
+		int paddedWidth = localWidth + 2;
+		thread_local std::vector<char> passable;
+		thread_local std::vector<int> costs;
+		passable.assign(paddedWidth * (localHeight + 2), 0);
+		costs.assign(passable.size(), -1);
+
+		for (int y = 0; y < localHeight; ++y) {
+			for (int x = 0; x < localWidth; ++x) {
+				pos_t pos { min.x + x, min.y + y };
+				passable[(y + 1) * paddedWidth + x + 1] =
+				    walkable.Get(util::posToIndex(pos, width_));
+			}
+		}
+
+		int start = util::posToIndex(origin - min + pos_t { 1, 1 },
+		                             paddedWidth);
+		if (!passable[start]) {
+			return;
+		}
+
+		int offsets[8];
+		for (int i = 0; i < 8; ++i) {
+			offsets[i] =
+			    kAllDirs[i].x + kAllDirs[i].y * paddedWidth;
+		}
+
+		// Small Dijkstra; the heap holds (cost, padded index) pairs
+		thread_local std::vector<std::pair<int, int>> open;
+		open.clear();
+
+		costs[start] = 0;
+		open.emplace_back(0, start);
+		const auto compare = std::greater<std::pair<int, int>> {};
+
+		while (!open.empty()) {
+			std::pop_heap(open.begin(), open.end(), compare);
+			auto [cost, index] = open.back();
+			open.pop_back();
+
+			if (cost != costs[index]) {
+				continue;
+			}
+
+			for (int i = 0; i < 8; ++i) {
+				int next = index + offsets[i];
+				if (!passable[next]) {
+					continue;
+				}
+
+				// Diagonals may not cut wall corners
+				bool diagonal = (i >= 4);
+				if (diagonal
+				    && (!passable[index + kAllDirs[i].x]
+				        || !passable[index
+				                     + kAllDirs[i].y
+				                           * paddedWidth])) {
+					continue;
+				}
+
+				int nextCost = cost
+				               + (diagonal ? kDiagonalCost
+				                           : kStraightCost);
+				if (costs[next] < 0 || nextCost < costs[next]) {
+					costs[next] = nextCost;
+					open.emplace_back(nextCost, next);
+					std::push_heap(open.begin(), open.end(),
+					               compare);
+				}
+			}
+		}
+
+		for (int y = 0; y < localHeight; ++y) {
+			for (int x = 0; x < localWidth; ++x) {
+				distances[y * localWidth + x] =
+				    costs[(y + 1) * paddedWidth + x + 1];
+			}
+		}
+	}
+
+	void NavGraph::BuildCluster(const BitGrid& walkable, int cx, int cy)
+	{
+		auto& cluster = clusters_[util::posToIndex(pos_t { cx, cy },
+		                                           clustersWide_)];
+		for (const auto& node : cluster.nodes) {
+			nodeAt_[node.tile] = -1;
+		}
+		cluster.nodes.clear();
+
+		// Entrances on all four borders, seen from this side. West and
+		// north borders are the neighbour's east and south, flipped.
+		Transitions transitions;
+		Transitions incoming;
+		if ((cx + 1) * kClusterSize < width_) {
+			CollectTransitions(walkable, cx, cy, true,
+			                   transitions);
+		}
+		if ((cy + 1) * kClusterSize < height_) {
+			CollectTransitions(walkable, cx, cy, false,
+			                   transitions);
+		}
+		if (cx > 0) {
+			CollectTransitions(walkable, cx - 1, cy, true,
+			                   incoming);
+		}
+		if (cy > 0) {
+			CollectTransitions(walkable, cx, cy - 1, false,
+			                   incoming);
+		}
+		for (const auto& [outer, inner] : incoming) {
+			transitions.emplace_back(inner, outer);
+		}
+
+		for (const auto& [inner, outer] : transitions) {
+			int& slot = nodeAt_[inner];
+			if (slot < 0) {
+				slot = static_cast<int>(cluster.nodes.size());
+				cluster.nodes.push_back(Node { inner, {} });
+			}
+			cluster.nodes[slot].edges.push_back(
+			    Edge { outer, kStraightCost });
+		}
+
+		// Intra-cluster costs between every pair of entrances
+		if (cluster.nodes.size() < 2) {
+			return;
+		}
+
+		pos_t min, max;
+		GetClusterBounds(pos_t { cx * kClusterSize, cy * kClusterSize },
+		                 min, max);
+
+		// Costs are symmetric, so one search per pair is enough
+		thread_local std::vector<int> distances;
+		auto& nodes = cluster.nodes;
+		for (std::size_t i = 0; i + 1 < nodes.size(); ++i) {
+			pos_t origin = util::indexToPos(nodes[i].tile, width_);
+			ClusterDistances(walkable, origin, distances);
+
+			for (std::size_t j = i + 1; j < nodes.size(); ++j) {
+				pos_t other =
+				    util::indexToPos(nodes[j].tile, width_);
+				int cost =
+				    distances[LocalIndex(other, min, max)];
+				if (cost >= 0) {
+					nodes[i].edges.push_back(
+					    Edge { nodes[j].tile, cost });
+					nodes[j].edges.push_back(
+					    Edge { nodes[i].tile, cost });
+				}
+			}
+		}
+	}
+
+	bool NavGraph::FindAbstractPath(const BitGrid& walkable, pos_t start,
+	                                pos_t goal,
+	                                PathfindingContext& context,
+	                                std::vector<pos_t>& waypoints,
+	                                PathfindingStats* stats) const
+	{
+		waypoints.clear();
+
+		// Temporary edges from start into its cluster's entrances, and
+		// from the goal cluster's entrances to goal
+		thread_local std::vector<int> startDistances;
+		thread_local std::vector<int> goalDistances;
+		ClusterDistances(walkable, start, startDistances);
+		ClusterDistances(walkable, goal, goalDistances);
+
+		pos_t startMin, startMax, goalMin, goalMax;
+		GetClusterBounds(start, startMin, startMax);
+		GetClusterBounds(goal, goalMin, goalMax);
+		int startCluster = ClusterIndex(start);
+		int goalCluster = ClusterIndex(goal);
+
+		auto startCost = [&](pos_t pos) {
+			return startDistances[LocalIndex(pos, startMin,
+			                                 startMax)];
+		};
+		auto goalCost = [&](pos_t pos) {
+			return goalDistances[LocalIndex(pos, goalMin, goalMax)];
+		};
+
+		int startIndex = util::posToIndex(start, width_);
+		int goalIndex = util::posToIndex(goal, width_);
+
+		context.Begin(width_, height_, 0);
+
+		auto relax = [&](int parentIndex, int index, int cost) {
+			if (context.stamps[index] == context.generation
+			    && context.costs[index] <= cost) {
+				return;
+			}
+
+			context.costs[index] = cost;
+			context.parents[index] = parentIndex;
+			context.stamps[index] = context.generation;
+
+			pos_t pos = util::indexToPos(index, width_);
+			context.open.push_back(
+			    { pos, cost + OctileDistance(pos, goal), cost });
+			std::push_heap(context.open.begin(), context.open.end(),
+			               kHeapCompare);
+		};
+
+		context.costs[startIndex] = 0;
+		context.parents[startIndex] = startIndex;
+		context.stamps[startIndex] = context.generation;
+		context.open.push_back(
+		    { start, OctileDistance(start, goal), 0 });
+
+		bool found = false;
+		while (!context.open.empty()) {
+			std::pop_heap(context.open.begin(), context.open.end(),
+			              kHeapCompare);
+			OpenNode current = context.open.back();
+			context.open.pop_back();
+
+			int index = util::posToIndex(current.pos, width_);
+			if (current.cost != context.costs[index]) {
+				continue;
+			}
+			if (stats) {
+				++stats->nodesExpanded;
+			}
+
+			if (index == goalIndex) {
+				found = true;
+				break;
+			}
+
+			int cluster = ClusterIndex(current.pos);
+
+			if (index == startIndex) {
+				const auto& entrances =
+				    clusters_[startCluster].nodes;
+				for (const auto& node : entrances) {
+					pos_t pos =
+					    util::indexToPos(node.tile, width_);
+					int cost = startCost(pos);
+
+					if (cost >= 0) {
+						relax(index, node.tile, cost);
+					}
+				}
+				if (goalCluster == startCluster) {
+					int cost = startCost(goal);
+					if (cost >= 0) {
+						relax(index, goalIndex, cost);
+					}
+				}
+			}
+
+			if (nodeAt_[index] >= 0) {
+				const auto& node =
+				    clusters_[cluster].nodes[nodeAt_[index]];
+				for (const auto& edge : node.edges) {
+					relax(index, edge.to,
+					      current.cost + edge.cost);
+				}
+
+				if (cluster == goalCluster) {
+					int cost = goalCost(current.pos);
+					if (cost >= 0) {
+						relax(index, goalIndex,
+						      current.cost + cost);
+					}
+				}
+			}
+		}
+
+		if (!found) {
+			return false;
+		}
+
+		for (int index = goalIndex;; index = context.parents[index]) {
+			waypoints.push_back(util::indexToPos(index, width_));
+			if (context.parents[index] == index) {
+				break;
+			}
+		}
+		std::reverse(waypoints.begin(), waypoints.end());
+
+		return true;
+	}
+} // namespace tutorial
@@ -1,14 +1,13 @@
 #include "PathFinding.hpp"
 
 #include "Map.hpp"
+#include "NavGraph.hpp"
+#include "Random.hpp"
 #include "Tile.hpp"
 #include "Util.hpp"
 
-#include <libtcod.h>
-
 #include <algorithm>
-#include <queue>
-#include <random>
+#include <functional>
 
 namespace tutorial
 {
@@ -22,23 +21,41 @@ namespace tutorial
 			{ -1, 0 }  // West
 		};
 
-		// Priority queue entry for best-first search
-		struct PathNode {
-			pos_t pos;
-			int distanceToGoal;
-
-			bool operator>(const PathNode& other) const
-			{
-				return distanceToGoal > other.distanceToGoal;
-			}
+		// All 8 directions, orthogonals first
+		constexpr pos_t kAllDirs[8] = {
+			{ 0, -1 }, { 1, 0 },  { 0, 1 },  { -1, 0 },
+			{ 1, -1 }, { 1, 1 },  { -1, 1 }, { -1, -1 }
 		};
 
+		// Octile step costs, scaled so diagonals stay integral
+		constexpr int kStraightCost = 10;
+		constexpr int kDiagonalCost = 14;
+
+		using Node = PathfindingContext::Node;
+
+		const auto kHeapCompare = std::greater<Node> {};
+
 		// Manhattan distance heuristic
 		int ManhattanDistance(pos_t a, pos_t b)
 		{
 			return std::abs(a.x - b.x) + std::abs(a.y - b.y);
 		}
 
+		// Octile distance heuristic, admissible for 8-way movement
+		int OctileDistance(pos_t a, pos_t b)
+		{
+			int dx = std::abs(a.x - b.x);
+			int dy = std::abs(a.y - b.y);
+			return kStraightCost * std::max(dx, dy)
+			       + (kDiagonalCost - kStraightCost)
+			             * std::min(dx, dy);
+		}
+
+		int Sign(int value)
+		{
+			return (value > 0) - (value < 0);
+		}
+
 		// Encode parent direction as DCSS does: (-dx + 2) * 4 + (-dy +
 		// 2) This gives us a unique negative number for each direction
 		int EncodeDirection(pos_t dir)
@@ -54,22 +71,577 @@ namespace tutorial
 			int dy = -(val % 4 - 2);
 			return pos_t { dx, dy };
 		}
+
+		// Grid queries shared by the 8-way searches
+		class Grid
+		{
+		public:
+			Grid(const Map& map, PathfindingContext& context,
+			     PathfindingStats* stats)
+			    : map_(map),
+			      context_(context),
+			      stats_(stats),
+			      min_ { 0, 0 },
+			      max_ { context.width - 1, context.height - 1 }
+			{
+			}
+
+			// Confine the search to an inclusive rectangle
+			void SetBounds(pos_t min, pos_t max)
+			{
+				min_ = min;
+				max_ = max;
+			}
+
+			bool IsPassable(pos_t pos) const
+			{
+				if (stats_) {
+					++stats_->nodesTouched;
+				}
+				return pos.x >= min_.x && pos.y >= min_.y
+				       && pos.x <= max_.x && pos.y <= max_.y
+				       && !map_.IsWall(pos);
+			}
+
+			// Diagonal moves may not cut wall corners
+			bool CanStep(pos_t from, pos_t dir) const
+			{
+				if (!IsPassable(from + dir)) {
+					return false;
+				}
+
+				if (dir.x != 0 && dir.y != 0) {
+					return IsPassable(
+					           { from.x + dir.x, from.y })
+					       && IsPassable(
+					           { from.x, from.y + dir.y });
+				}
+
+				return true;
+			}
+
+			int Index(pos_t pos) const
+			{
+				return util::posToIndex(pos, context_.width);
+			}
+
+			bool HasCost(int index) const
+			{
+				return context_.stamps[index]
+				       == context_.generation;
+			}
+
+			// Relax the edge parent -> pos, pushing pos if improved
+			void Relax(pos_t parent, pos_t pos, pos_t end)
+			{
+				int parentIndex = Index(parent);
+				int index = Index(pos);
+				int cost = context_.costs[parentIndex]
+				           + OctileDistance(parent, pos);
+
+				if (HasCost(index)
+				    && context_.costs[index] <= cost) {
+					return;
+				}
+
+				context_.costs[index] = cost;
+				context_.parents[index] = parentIndex;
+				context_.stamps[index] = context_.generation;
+
+				context_.open.push_back(
+				    { pos, cost + OctileDistance(pos, end),
+				      cost });
+				std::push_heap(context_.open.begin(),
+				               context_.open.end(),
+				               kHeapCompare);
+			}
+
+			// Pop the best open node, skipping entries superseded
+			// by a cheaper route. Returns false when the open list
+			// is empty.
+			bool PopBest(Node& node)
+			{
+				auto& open = context_.open;
+				while (!open.empty()) {
+					std::pop_heap(open.begin(), open.end(),
+					              kHeapCompare);
+					node = open.back();
+					open.pop_back();
+
+					int index = Index(node.pos);
+					if (node.cost
+					    == context_.costs[index]) {
+						if (stats_) {
+							++stats_->nodesExpanded;
+						}
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void Seed(pos_t start, pos_t end)
+			{
+				int index = Index(start);
+				context_.costs[index] = 0;
+				context_.parents[index] = index;
+				context_.stamps[index] = context_.generation;
+				context_.open.push_back(
+				    { start, OctileDistance(start, end), 0 });
+			}
+
+		private:
+			const Map& map_;
+			PathfindingContext& context_;
+			PathfindingStats* stats_;
+			pos_t min_;
+			pos_t max_;
+		};
+
+		bool SearchBestFirst(const Map& map, pos_t start, pos_t end,
+		                     PathfindingContext& context,
+		                     PathfindingStats* stats)
+		{
+			// Open list kept as a binary min-heap on distance to
+			// goal
+			auto& open = context.open;
+
+			// Start searching
+			open.push_back(
+			    { start, ManhattanDistance(start, end) });
+			context.SetDistance(start, 1); // Mark as visited
+
+			while (!open.empty()) {
+				std::pop_heap(open.begin(), open.end(),
+				              kHeapCompare);
+				Node current = open.back();
+				open.pop_back();
+
+				if (stats) {
+					++stats->nodesExpanded;
+				}
+
+				// Check if we reached the goal
+				if (current.pos == end) {
+					return true;
+				}
+
+				// Randomize neighbor order (DCSS does this for
+				// variety)
+				int dirIndices[4] = { 0, 1, 2, 3 };
+				for (int i = 3; i > 0; --i) {
+					int j = static_cast<int>(
+					    context.NextRandom() % (i + 1));
+					std::swap(dirIndices[i], dirIndices[j]);
+				}
+
+				// Try all orthogonal neighbors
+				for (int dirIdx : dirIndices) {
+					pos_t dir = kOrthogonalDirs[dirIdx];
+					pos_t neighbor = current.pos + dir;
+
+					if (stats) {
+						++stats->nodesTouched;
+					}
+
+					// Skip if out of bounds
+					if (!context.InBounds(neighbor)) {
+						continue;
+					}
+
+					// Skip if wall
+					if (map.IsWall(neighbor)) {
+						continue;
+					}
+
+					// Skip if already visited
+					if (context.GetDistance(neighbor)
+					    != 0) {
+						continue;
+					}
+
+					// Mark as visited and encode parent
+					// direction
+					context.SetDistance(
+					    neighbor, EncodeDirection(dir));
+
+					// Add to open list
+					int distToGoal =
+					    ManhattanDistance(neighbor, end);
+					open.push_back(
+					    { neighbor, distToGoal });
+					std::push_heap(open.begin(), open.end(),
+					               kHeapCompare);
+				}
+			}
+
+			return false;
+		}
+
+		void ReconstructBestFirst(pos_t start, pos_t end,
+		                          const PathfindingContext& context,
+		                          std::vector<pos_t>& path)
+		{
+			// Walk backwards from end to start
+			pos_t current = end;
+
+			while (current != start) {
+				path.push_back(current);
+
+				// Decode parent direction and move backwards
+				int encoded = context.GetDistance(current);
+				pos_t dir = DecodeDirection(encoded);
+				// Subtract to go back to parent
+				current = current - dir;
+			}
+
+			path.push_back(start);
+		}
+
+		bool SearchAStar(const Map& map, pos_t start, pos_t end,
+		                 PathfindingContext& context,
+		                 PathfindingStats* stats,
+		                 const pos_t* boundsMin = nullptr,
+		                 const pos_t* boundsMax = nullptr)
+		{
+			Grid grid(map, context, stats);
+			if (boundsMin && boundsMax) {
+				grid.SetBounds(*boundsMin, *boundsMax);
+			}
+			grid.Seed(start, end);
+
+			Node current;
+			while (grid.PopBest(current)) {
+				if (current.pos == end) {
+					return true;
+				}
+
+				for (pos_t dir : kAllDirs) {
+					if (grid.CanStep(current.pos, dir)) {
+						grid.Relax(current.pos,
+						           current.pos + dir,
+						           end);
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// Scan from pos in direction dir until a jump point, the goal,
+		// or a dead end. Forced-neighbour rules are the variant for
+		// movement that may not cut corners, so JPS paths are walkable
+		// by the same rules as AStar.
+		bool Jump(const Grid& grid, pos_t pos, pos_t dir, pos_t end,
+		          pos_t& jumpPoint)
+		{
+			while (true) {
+				if (!grid.IsPassable(pos)) {
+					return false;
+				}
+
+				if (pos == end) {
+					jumpPoint = pos;
+					return true;
+				}
+
+				if (dir.x != 0 && dir.y != 0) {
+					pos_t unused;
+					if (Jump(grid, { pos.x + dir.x, pos.y },
+					         { dir.x, 0 }, end, unused)
+					    || Jump(grid,
+					            { pos.x, pos.y + dir.y },
+					            { 0, dir.y }, end,
+					            unused)) {
+						jumpPoint = pos;
+						return true;
+					}
+				} else if (dir.x != 0) {
+					int behind = pos.x - dir.x;
+					pos_t up { pos.x, pos.y - 1 };
+					pos_t down { pos.x, pos.y + 1 };
+					if ((grid.IsPassable(up)
+					     && !grid.IsPassable(
+					         { behind, up.y }))
+					    || (grid.IsPassable(down)
+					        && !grid.IsPassable(
+					            { behind, down.y }))) {
+						jumpPoint = pos;
+						return true;
+					}
+				} else {
+					int behind = pos.y - dir.y;
+					pos_t left { pos.x - 1, pos.y };
+					pos_t right { pos.x + 1, pos.y };
+					if ((grid.IsPassable(left)
+					     && !grid.IsPassable(
+					         { left.x, behind }))
+					    || (grid.IsPassable(right)
+					        && !grid.IsPassable(
+					            { right.x, behind }))) {
+						jumpPoint = pos;
+						return true;
+					}
+				}
+
+				// Keep going only if the next step is legal
+				if (!grid.IsPassable({ pos.x + dir.x, pos.y })
+				    || !grid.IsPassable(
+				        { pos.x, pos.y + dir.y })) {
+					return false;
+				}
+
+				pos = pos + dir;
+			}
+		}
+
+		// Pruned successor directions for a node reached along dir
+		int PrunedDirections(const Grid& grid, pos_t pos, pos_t dir,
+		                     pos_t (&out)[8])
+		{
+			int count = 0;
+			auto add = [&](pos_t d) { out[count++] = d; };
+
+			if (dir.x != 0 && dir.y != 0) {
+				bool vertical =
+				    grid.IsPassable({ pos.x, pos.y + dir.y });
+				bool horizontal =
+				    grid.IsPassable({ pos.x + dir.x, pos.y });
+				if (vertical) {
+					add({ 0, dir.y });
+				}
+				if (horizontal) {
+					add({ dir.x, 0 });
+				}
+				if (vertical && horizontal) {
+					add(dir);
+				}
+			} else if (dir.x != 0) {
+				bool next = grid.IsPassable(pos + dir);
+				bool down =
+				    grid.IsPassable({ pos.x, pos.y + 1 });
+				bool up = grid.IsPassable({ pos.x, pos.y - 1 });
+				if (next) {
+					add(dir);
+					if (down) {
+						add({ dir.x, 1 });
+					}
+					if (up) {
+						add({ dir.x, -1 });
+					}
+				}
+				if (down) {
+					add({ 0, 1 });
+				}
+				if (up) {
+					add({ 0, -1 });
+				}
+			} else {
+				bool next = grid.IsPassable(pos + dir);
+				bool right =
+				    grid.IsPassable({ pos.x + 1, pos.y });
+				bool left =
+				    grid.IsPassable({ pos.x - 1, pos.y });
+
+				if (next) {
+					add(dir);
+					if (right) {
+						add({ 1, dir.y });
+					}
+					if (left) {
+						add({ -1, dir.y });
+					}
+				}
+				if (right) {
+					add({ 1, 0 });
+				}
+				if (left) {
+					add({ -1, 0 });
+				}
+			}
+
+			return count;
+		}
+
+		bool SearchJumpPoint(const Map& map, pos_t start, pos_t end,
+		                     PathfindingContext& context,
+		                     PathfindingStats* stats)
+		{
+			Grid grid(map, context, stats);
+			grid.Seed(start, end);
+
+			Node current;
+			while (grid.PopBest(current)) {
+				if (current.pos == end) {
+					return true;
+				}
+
+				// The start has no parent, so every direction
+				// is a candidate; otherwise prune by arrival
+				// direction
+				pos_t dirs[8];
+				int count = 0;
+				int index = grid.Index(current.pos);
+				int parentIndex = context.parents[index];
+
+				if (parentIndex == index) {
+					for (pos_t dir : kAllDirs) {
+						if (grid.CanStep(current.pos,
+						                 dir)) {
+							dirs[count++] = dir;
+						}
+					}
+				} else {
+					pos_t parent = util::indexToPos(
+					    parentIndex, context.width);
+					pos_t dir {
+						Sign(current.pos.x - parent.x),
+						Sign(current.pos.y - parent.y)
+					};
+					count = PrunedDirections(
+					    grid, current.pos, dir, dirs);
+				}
+
+				for (int i = 0; i < count; ++i) {
+					pos_t jumpPoint;
+					if (Jump(grid, current.pos + dirs[i],
+					         dirs[i], end, jumpPoint)) {
+						grid.Relax(current.pos,
+						           jumpPoint, end);
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// Follow parent links from end, filling in the straight or
+		// diagonal run between consecutive jump points
+		void ReconstructFromParents(pos_t end,
+		                            const PathfindingContext& context,
+		                            std::vector<pos_t>& path)
+		{
+			int index = util::posToIndex(end, context.width);
+
+			while (true) {
+				int parentIndex = context.parents[index];
+				pos_t pos =
+				    util::indexToPos(index, context.width);
+
+				if (parentIndex == index) {
+					path.push_back(pos);
+					return;
+				}
+
+				pos_t parent = util::indexToPos(parentIndex,
+				                                context.width);
+				pos_t step { Sign(parent.x - pos.x),
+					     Sign(parent.y - pos.y) };
+
+				for (; pos != parent; pos = pos + step) {
+					path.push_back(pos);
+				}
+
+				index = parentIndex;
+			}
+		}
+
+		// Plan over the NavGraph, then replace each leg inside a
+		// cluster with a grid path confined to that cluster. Legs
+		// between clusters are single orthogonal steps. The path is
+		// built end->start like the others.
+		bool SearchHierarchical(const Map& map, pos_t start, pos_t end,
+		                        PathfindingContext& context,
+		                        std::vector<pos_t>& path,
+		                        PathfindingStats* stats)
+		{
+			const auto& graph = map.GetNavGraph();
+			thread_local std::vector<pos_t> waypoints;
+
+			if (!graph.FindAbstractPath(map.GetWalkablePlane(),
+			                            start, end, context,
+			                            waypoints, stats)) {
+				return false;
+			}
+
+			for (std::size_t i = waypoints.size() - 1; i > 0; --i) {
+				pos_t from = waypoints[i - 1];
+				pos_t to = waypoints[i];
+
+				pos_t fromMin, fromMax, toMin, toMax;
+				graph.GetClusterBounds(from, fromMin, fromMax);
+				graph.GetClusterBounds(to, toMin, toMax);
+
+				if (fromMin != toMin) {
+					path.push_back(to);
+					continue;
+				}
+
+				context.Begin(map.GetWidth(), map.GetHeight(),
+				              0);
+				if (!SearchAStar(map, from, to, context, stats,
+				                 &fromMin, &fromMax)) {
+					// The graph promised this leg; only a
+					// stale graph can get here
+					path.clear();
+					return false;
+				}
+
+				ReconstructFromParents(to, context, path);
+				path.pop_back(); // from, pushed by the next leg
+			}
+
+			path.push_back(start);
+			return true;
+		}
 	} // namespace
 
 	// PathfindingContext implementation
 	PathfindingContext::PathfindingContext(int w, int h)
-	    : distances(w * h, 0), width(w), height(h)
+	    : distances(w * h, 0),
+	      costs(w * h, 0),
+	      parents(w * h, 0),
+	      stamps(w * h, 0),
+	      width(w),
+	      height(h)
 	{
 	}
 
+	void PathfindingContext::Begin(int w, int h, std::uint32_t seed)
+	{
+		size_t size = static_cast<size_t>(w) * h;
+		if (stamps.size() < size) {
+			distances.resize(size);
+			costs.resize(size);
+			parents.resize(size);
+			stamps.resize(size, 0);
+		}
+
+		width = w;
+		height = h;
+		open.clear();
+
+		// On wrap-around, old stamps could alias the new generation
+		if (++generation == 0) {
+			std::fill(stamps.begin(), stamps.end(), 0);
+			generation = 1;
+		}
+
+		// xorshift has a fixed point at zero
+		rngState = (seed != 0) ? seed : 0x9E3779B9u;
+	}
+
 	int PathfindingContext::GetDistance(pos_t pos) const
 	{
-		return distances[util::posToIndex(pos, width)];
+		int index = util::posToIndex(pos, width);
+		return (stamps[index] == generation) ? distances[index] : 0;
 	}
 
 	void PathfindingContext::SetDistance(pos_t pos, int value)
 	{
-		distances[util::posToIndex(pos, width)] = value;
+		int index = util::posToIndex(pos, width);
+		distances[index] = value;
+		stamps[index] = generation;
 	}
 
 	bool PathfindingContext::InBounds(pos_t pos) const
@@ -78,111 +650,174 @@ namespace tutorial
 		       && pos.y < height;
 	}
 
-	// Main pathfinding function - DCSS-style best-first search
-	std::vector<pos_t> FindPath(const Map& map, pos_t start, pos_t end)
+	std::uint32_t PathfindingContext::NextRandom()
+	{
+		rngState ^= rngState << 13;
+		rngState ^= rngState >> 17;
+		rngState ^= rngState << 5;
+		return rngState;
+	}
+
+	PathfindingContext& PathfindingContext::ThreadLocal()
+	{
+		thread_local PathfindingContext context;
+		return context;
+	}
+
+	bool FindPath(const Map& map, pos_t start, pos_t end,
+	              std::vector<pos_t>& path, PathAlgorithm algorithm,
+	              PathfindingStats* stats)
 	{
+		path.clear();
+
+		if (stats) {
+			*stats = PathfindingStats {};
+		}
+
 		// Early exit if start or end is invalid
 		if (!map.IsInBounds(start) || !map.IsInBounds(end)) {
-			return {};
+			return false;
 		}
 
 		if (map.IsWall(start) || map.IsWall(end)) {
-			return {};
+			return false;
 		}
 
 		// If already at destination
 		if (start == end) {
-			return { start };
+			path.push_back(start);
+			return true;
 		}
 
-		// Initialize pathfinding context
-		PathfindingContext context(map.GetWidth(), map.GetHeight());
-
-		// Priority queue for best-first search
-		std::priority_queue<PathNode, std::vector<PathNode>,
-		                    std::greater<PathNode>>
-		    queue;
-
-		// Start searching
-		queue.push({ start, ManhattanDistance(start, end) });
-		context.SetDistance(start, 1); // Mark as visited
+		// Reuse this thread's context; one draw from the game RNG seeds
+		// the neighbour shuffle for the whole query
+		auto& context = PathfindingContext::ThreadLocal();
+		std::uint32_t seed = 0;
+		if (algorithm == PathAlgorithm::BestFirst) {
+			seed = static_cast<std::uint32_t>(
+			    GetRandom(RandomStream::Pathfinding).Next());
+		}
+		context.Begin(map.GetWidth(), map.GetHeight(), seed);
+
+		bool found = false;
+		switch (algorithm) {
+			case PathAlgorithm::BestFirst:
+				found = SearchBestFirst(map, start, end,
+				                        context, stats);
+				if (found) {
+					ReconstructBestFirst(start, end,
+					                     context, path);
+				}
+				break;
+			case PathAlgorithm::AStar:
+				found = SearchAStar(map, start, end,
+				                    context, stats);
+				if (found) {
+					ReconstructFromParents(end, context,
+					                       path);
+				}
+				break;
+			case PathAlgorithm::JumpPoint:
+				found = SearchJumpPoint(map, start, end,
+				                        context, stats);
+				if (found) {
+					ReconstructFromParents(end, context,
+					                       path);
+				}
+				break;
+			case PathAlgorithm::Hierarchical:
+				found = SearchHierarchical(
+				    map, start, end, context, path, stats);
+				break;
+		}
 
-		auto* rand = TCODRandom::getInstance();
-		bool foundPath = false;
+		// Paths are built end->start; reverse to get start->end order
+		std::reverse(path.begin(), path.end());
 
-		while (!queue.empty()) {
-			PathNode current = queue.top();
-			queue.pop();
+		return found;
+	}
 
-			// Check if we reached the goal
-			if (current.pos == end) {
-				foundPath = true;
-				break;
-			}
+	PathCache::PathCache(std::size_t capacity) : capacity_(capacity)
+	{
+		entries_.reserve(capacity_);
+	}
 
-			// Randomize neighbor order (DCSS does this for variety)
-			std::vector<int> dirIndices = { 0, 1, 2, 3 };
-			std::shuffle(dirIndices.begin(), dirIndices.end(),
-			             std::default_random_engine(
-			                 rand->getInt(0, 999999)));
+	bool PathCache::FindPath(const Map& map, pos_t start, pos_t end,
+	                         std::vector<pos_t>& path,
+	                         PathAlgorithm algorithm,
+	                         PathfindingStats* stats)
+	{
+		unsigned int version = map.GetTerrainVersion();
 
-			// Try all orthogonal neighbors
-			for (int dirIdx : dirIndices) {
-				pos_t dir = kOrthogonalDirs[dirIdx];
-				pos_t neighbor = current.pos + dir;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
 
-				// Skip if out of bounds
-				if (!context.InBounds(neighbor)) {
+			for (auto& entry : entries_) {
+				if (entry.end != end
+				    || entry.algorithm != algorithm
+				    || entry.terrainVersion != version) {
 					continue;
 				}
 
-				// Skip if wall
-				if (map.IsWall(neighbor)) {
+				auto it = std::find(entry.route.begin(),
+				                    entry.route.end(), start);
+				if (it == entry.route.end()) {
 					continue;
 				}
 
-				// Skip if already visited
-				if (context.GetDistance(neighbor) != 0) {
-					continue;
+				// Any tail of a route is itself a route
+				path.assign(it, entry.route.end());
+				entry.lastUsed = ++clock_;
+				if (stats) {
+					*stats = PathfindingStats {};
+					stats->cacheHits = 1;
 				}
-
-				// Mark as visited and encode parent direction
-				context.SetDistance(neighbor,
-				                    EncodeDirection(dir));
-
-				// Add to queue
-				int distToGoal =
-				    ManhattanDistance(neighbor, end);
-				queue.push({ neighbor, distToGoal });
+				return true;
 			}
 		}
 
-		// If no path found, return empty vector
-		if (!foundPath) {
-			return {};
+		// Search unlocked so other threads can still hit meanwhile
+		bool found =
+		    tutorial::FindPath(map, start, end, path, algorithm, stats);
+		if (stats) {
+			stats->cacheMisses = 1;
+		}
+		if (!found || capacity_ == 0) {
+			return found;
 		}
 
-		// Reconstruct path by walking backwards from end to start
-		std::vector<pos_t> path;
-		pos_t current = end;
-
-		while (current != start) {
-			path.push_back(current);
-
-			// Decode parent direction and move backwards
-			int encoded = context.GetDistance(current);
-			pos_t dir = DecodeDirection(encoded);
-			current =
-			    current - dir; // Subtract to go back to parent
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		// Stale routes go first, then the least recently used
+		Entry* slot = nullptr;
+		if (entries_.size() < capacity_) {
+			slot = &entries_.emplace_back();
+		} else {
+			slot = &entries_.front();
+			for (auto& entry : entries_) {
+				if (entry.terrainVersion != version) {
+					slot = &entry;
+					break;
+				}
+				if (entry.lastUsed < slot->lastUsed) {
+					slot = &entry;
+				}
+			}
 		}
 
-		// Add start position
-		path.push_back(start);
+		slot->end = end;
+		slot->algorithm = algorithm;
+		slot->terrainVersion = version;
+		slot->lastUsed = ++clock_;
+		slot->route.assign(path.begin(), path.end());
 
-		// Reverse to get start->end order
-		std::reverse(path.begin(), path.end());
+		return true;
+	}
 
-		return path;
+	void PathCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.clear();
 	}
 
 } // namespace tutorial
@@ -0,0 +1,139 @@
+#include "Random.hpp"
+
+#include <random>
+#include <utility>
+
+namespace tutorial
+{
+	inline namespace
+	{
+		constexpr std::size_t kStreamCount =
+		    static_cast<std::size_t>(RandomStream::Count);
+
+		thread_local std::array<Rng*, kStreamCount> overrides {};
+
+		// SplitMix64 finaliser: spreads nearby seeds far apart
+		std::uint64_t Mix(std::uint64_t value)
+		{
+			value += 0x9E3779B97F4A7C15ULL;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		std::uint64_t RotateLeft(std::uint64_t value, int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+	} // namespace
+
+	Rng::Rng(std::uint64_t seed)
+	{
+		for (auto& word : state_) {
+			seed = Mix(seed);
+			word = seed;
+		}
+	}
+
+	std::uint64_t Rng::Next()
+	{
+		std::uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+		std::uint64_t shifted = state_[1] << 17;
+
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= shifted;
+		state_[3] = RotateLeft(state_[3], 45);
+
+		return result;
+	}
+
+	int Rng::GetInt(int min, int max)
+	{
+		if (min > max) {
+			std::swap(min, max);
+		}
+
+		// Multiply-shift maps 32 random bits onto the range without a
+		// division
+		std::uint64_t range = static_cast<std::uint64_t>(
+		    static_cast<std::int64_t>(max) - min + 1);
+		std::uint64_t offset = ((Next() >> 32) * range) >> 32;
+
+		return static_cast<int>(static_cast<std::int64_t>(min)
+		                        + static_cast<std::int64_t>(offset));
+	}
+
+	float Rng::GetFloat(float min, float max)
+	{
+		// 24 bits fill a float mantissa exactly
+		float unit = static_cast<float>(Next() >> 40) * 0x1.0p-24F;
+		return min + (max - min) * unit;
+	}
+
+	Rng Rng::Split()
+	{
+		return Rng(Next());
+	}
+
+	RandomService& RandomService::Instance()
+	{
+		static RandomService instance;
+		return instance;
+	}
+
+	RandomService::RandomService()
+	{
+		Seed(std::random_device {}());
+	}
+
+	void RandomService::Seed(std::uint64_t masterSeed)
+	{
+		masterSeed_ = masterSeed;
+
+		Rng root(masterSeed);
+		for (auto& stream : streams_) {
+			stream = root.Split();
+		}
+	}
+
+	Rng RandomService::ForLevel(std::uint64_t masterSeed,
+	                            RandomStream stream, int dungeonLevel)
+	{
+		std::uint64_t key =
+		    (static_cast<std::uint64_t>(stream) << 32)
+		    | static_cast<std::uint32_t>(dungeonLevel);
+		return Rng(Mix(masterSeed ^ Mix(key)));
+	}
+
+	Rng& GetRandom(RandomStream stream)
+	{
+		Rng* rng = overrides[static_cast<std::size_t>(stream)];
+		return rng ? *rng : RandomService::Instance().Get(stream);
+	}
+
+	ScopedRandom::ScopedRandom(RandomStream stream, Rng& rng)
+	    : stream_(stream),
+	      previous_(overrides[static_cast<std::size_t>(stream)])
+	{
+		overrides[static_cast<std::size_t>(stream)] = &rng;
+	}
+
+	ScopedRandom::~ScopedRandom()
+	{
+		overrides[static_cast<std::size_t>(stream_)] = previous_;
+	}
+
+	ScopedLevelRandom::ScopedLevelRandom(std::uint64_t masterSeed,
+	                                     int dungeonLevel)
+	    : generation_(RandomService::ForLevel(
+	          masterSeed, RandomStream::Generation, dungeonLevel)),
+	      spawning_(RandomService::ForLevel(
+	          masterSeed, RandomStream::Spawning, dungeonLevel)),
+	      generationScope_(RandomStream::Generation, generation_),
+	      spawningScope_(RandomStream::Spawning, spawning_)
+	{
+	}
+} // namespace tutorial
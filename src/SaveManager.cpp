@@ -12,13 +12,16 @@
 #include "LevelConfig.hpp"
 #include "LocaleManager.hpp"
 #include "Map.hpp"
+#include "Random.hpp"
 #include "TemplateRegistry.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 
 namespace fs = std::filesystem;
@@ -69,7 +72,7 @@ namespace tutorial
 		// Clear existing state
 		engine.entities_.Clear();
 		engine.messageLog_.Clear();
-		engine.eventQueue_.clear();
+		engine.eventQueue_.Clear();
 		engine.entitiesToRemove_.clear();
 
 		// Restore dungeon level
@@ -82,6 +85,15 @@ namespace tutorial
 			engine.dungeonLevel_ = 1;
 		}
 
+		// Restore the master seed so the level regenerates as it was
+		// first generated. Older saves get a fresh one.
+		if (j.contains("rng") && j["rng"].contains("masterSeed")) {
+			RandomService::Instance().Seed(
+			    j["rng"]["masterSeed"].get<std::uint64_t>());
+		} else {
+			RandomService::Instance().Seed(std::random_device {}());
+		}
+
 		return true;
 	}
 
@@ -108,12 +120,13 @@ namespace tutorial
 		pos_t safePos = engine.map_->GetRooms()[0].GetCenter();
 		playerEntity->SetPos(safePos);
 
-		engine.player_ =
-		    engine.entities_.Spawn(std::move(playerEntity)).get();
+		Entity* player =
+		    engine.entities_.Spawn(std::move(playerEntity));
+		engine.player_ = player->GetHandle();
 
 		std::cout << "[SaveManager] Player restored at ("
-		          << engine.player_->GetPos().x << ", "
-		          << engine.player_->GetPos().y << ") "
+		          << player->GetPos().x << ", "
+		          << player->GetPos().y << ") "
 		          << "(placed at first room center)" << std::endl;
 
 		// Create UI components
@@ -122,7 +135,7 @@ namespace tutorial
 		engine.healthBar_ = std::make_unique<HealthBar>(
 		    cfg.GetHealthBarWidth(), cfg.GetHealthBarHeight(),
 		    pos_t { cfg.GetHealthBarX(), cfg.GetHealthBarY() },
-		    *engine.player_);
+		    *player);
 
 		int invWidth = cfg.GetInventoryWindowWidth();
 		int invHeight = cfg.GetInventoryWindowHeight();
@@ -139,7 +152,7 @@ namespace tutorial
 		}
 
 		engine.inventoryWindow_ = std::make_unique<InventoryWindow>(
-		    invWidth, invHeight, invPos, *engine.player_);
+		    invWidth, invHeight, invPos, *player);
 
 		return true;
 	}
@@ -152,11 +165,9 @@ namespace tutorial
 		          << std::endl;
 
 		const auto& rooms = engine.map_->GetRooms();
-		for (size_t i = 1; i < rooms.size(); ++i) {
-			engine.entities_.PlaceEntities(
-			    rooms[i], config.monsterSpawning, config.id);
-			engine.entities_.PlaceItems(
-			    rooms[i], config.itemSpawning, config.id);
+		if (!rooms.empty()) {
+			engine.entities_.PopulateRooms(rooms.begin() + 1,
+			                               rooms.end(), config);
 		}
 
 		// Place stairs in last room
@@ -166,7 +177,7 @@ namespace tutorial
 			    "stairs_down", stairsPos);
 			engine.stairs_ =
 			    engine.entities_.Spawn(std::move(stairsEntity))
-			        .get();
+			        ->GetHandle();
 			std::cout << "[SaveManager] Placed stairs at ("
 			          << stairsPos.x << ", " << stairsPos.y << ")"
 			          << std::endl;
@@ -629,14 +640,18 @@ namespace tutorial
 		j["level"]["id"] = engine.GetCurrentLevelId();
 		j["level"]["dungeonLevel"] = engine.GetDungeonLevel();
 
+		// Master seed, from which every level's streams are derived
+		j["rng"]["masterSeed"] =
+		    RandomService::Instance().GetMasterSeed();
+
 		// Serialize message log
 		nlohmann::json messages = nlohmann::json::array();
 		j["messageLog"] = messages;
 
 		// Serialize entities (excluding player)
 		nlohmann::json entities = nlohmann::json::array();
-		for (const auto& entity : engine.GetEntities()) {
-			if (entity.get() != player) {
+		for (auto* entity : engine.GetEntities()) {
+			if (entity != player) {
 				entities.push_back(SerializeEntity(*entity));
 			}
 		}
@@ -654,6 +669,9 @@ namespace tutorial
 		try {
 			engine.EnsureInitialized();
 
+			// A pending build reads the templates reloaded below
+			engine.levelPrefetcher_.Cancel();
+
 			// Step 1: Load level configuration
 			std::string levelId =
 			    j["level"]["id"].get<std::string>();
@@ -680,8 +698,10 @@ namespace tutorial
 			SaveManager::InitializeEngineState(engine, j);
 
 			// Step 4: Regenerate map
-			engine.GenerateMap(levelConfig.generation.width,
-			                   levelConfig.generation.height);
+			ScopedLevelRandom levelRandom(
+			    RandomService::Instance().GetMasterSeed(),
+			    engine.dungeonLevel_);
+			engine.GenerateMap();
 			engine.map_->Update();
 
 			std::cout << "[SaveManager] Map regenerated: "
@@ -706,11 +726,11 @@ namespace tutorial
 			                                         levelConfig);
 
 			// Step 7: Recompute FOV
-			if (engine.player_) {
+			if (auto* player = engine.GetPlayer()) {
 				std::cout << "[SaveManager] Computing FOV at "
 				             "player position ("
-				          << engine.player_->GetPos().x << ", "
-				          << engine.player_->GetPos().y << ")"
+				          << player->GetPos().x << ", "
+				          << player->GetPos().y << ")"
 				          << std::endl;
 				engine.ComputeFOV();
 				engine.map_->Update();
@@ -729,6 +749,8 @@ namespace tutorial
 			engine.messageLog_.AddMessage(
 			    "Welcome back, adventurer!", msg.color, false);
 
+			engine.PrefetchNextLevel();
+
 			std::cout
 			    << "[SaveManager] Game state restored successfully"
 			    << std::endl;
@@ -0,0 +1,108 @@
+#include "ScentField.hpp"
+
+#include "AiComponent.hpp"
+#include "Util.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace tutorial
+{
+	void ScentField::Resize(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+		values_.assign(width * height, 0);
+		currentValue_ = SCENT_THRESHOLD;
+	}
+
+	void ScentField::Deposit(const BitGrid& fov, pos_t boxMin,
+	                         pos_t boxMax, pos_t source)
+	{
+		// Increment scent value each turn
+		++currentValue_;
+
+		for (int y = boxMin.y; y <= boxMax.y; ++y) {
+			int rowStart = y * width_;
+			int dy = std::abs(y - source.y);
+
+			for (int x = boxMin.x; x <= boxMax.x; ++x) {
+				int index = rowStart + x;
+				if (!fov.Get(index)) {
+					continue;
+				}
+
+				// New scent = current turn value minus
+				// Manhattan distance to the source
+				unsigned int newScent =
+				    currentValue_
+				    - (std::abs(x - source.x) + dy);
+
+				// Only update if new scent is stronger than old
+				if (newScent > values_[index]) {
+					values_[index] = newScent;
+				}
+			}
+		}
+	}
+
+	void ScentField::Relax(const BitGrid& walkable, int index, int x,
+	                       int y)
+	{
+		if (!walkable.Get(index)) {
+			return;
+		}
+
+		unsigned int best = 0;
+		if (x > 0) {
+			best = std::max(best, values_[index - 1]);
+		}
+		if (x < width_ - 1) {
+			best = std::max(best, values_[index + 1]);
+		}
+		if (y > 0) {
+			best = std::max(best, values_[index - width_]);
+		}
+		if (y < height_ - 1) {
+			best = std::max(best, values_[index + width_]);
+		}
+
+		if (best > values_[index] + 1) {
+			values_[index] = best - 1;
+		}
+	}
+
+	void ScentField::Diffuse(const BitGrid& walkable, pos_t boxMin,
+	                         pos_t boxMax, int range)
+	{
+		int minX = std::max(0, boxMin.x - range);
+		int minY = std::max(0, boxMin.y - range);
+		int maxX = std::min(width_ - 1, boxMax.x + range);
+		int maxY = std::min(height_ - 1, boxMax.y + range);
+
+		// A forward then a backward sweep carries scent around most
+		// corners in a single turn; anything left converges over the
+		// following turns
+		for (int y = minY; y <= maxY; ++y) {
+			for (int x = minX; x <= maxX; ++x) {
+				Relax(walkable, y * width_ + x, x, y);
+			}
+		}
+
+		for (int y = maxY; y >= minY; --y) {
+			for (int x = maxX; x >= minX; --x) {
+				Relax(walkable, y * width_ + x, x, y);
+			}
+		}
+	}
+
+	unsigned int ScentField::Get(pos_t pos) const
+	{
+		if (pos.x < 0 || pos.y < 0 || pos.x >= width_
+		    || pos.y >= height_) {
+			return 0;
+		}
+
+		return values_[util::posToIndex(pos, width_)];
+	}
+} // namespace tutorial
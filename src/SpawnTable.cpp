@@ -1,6 +1,6 @@
 #include "SpawnTable.hpp"
 
-#include <libtcod/mersenne.hpp>
+#include "Random.hpp"
 
 #include <numeric>
 
@@ -23,8 +23,8 @@ namespace tutorial
 		int totalWeight = GetTotalWeight();
 
 		// Roll random number from 0 to totalWeight-1
-		auto* rand = TCODRandom::getInstance();
-		int roll = rand->getInt(0, totalWeight - 1);
+		auto& rand = GetRandom(RandomStream::Spawning);
+		int roll = rand.GetInt(0, totalWeight - 1);
 
 		// Find which entry the roll lands in
 		int currentWeight = 0;
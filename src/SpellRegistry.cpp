@@ -3,6 +3,7 @@
 #include "Effect.hpp"
 #include "TargetSelector.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -152,6 +153,15 @@ namespace tutorial
 		return ids;
 	}
 
+	float SpellRegistry::GetMaxRange() const
+	{
+		float maxRange = 0.0f;
+		for (const auto& pair : spells_) {
+			maxRange = std::max(maxRange, pair.second.range);
+		}
+		return maxRange;
+	}
+
 	SpellData SpellRegistry::LoadSpell(const std::string& id,
 	                                   const std::string& filePath)
 	{
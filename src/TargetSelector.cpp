@@ -5,37 +5,14 @@
 #include "LocaleManager.hpp"
 #include "Map.hpp"
 
-#include <libtcod/bresenham.hpp>
-
 namespace tutorial
 {
-	// Helper: Check line-of-sight using Bresenham's line algorithm
+	// Helper: Check line-of-sight against the engine's ray tables
 	bool TargetSelector::HasLineOfSight(Engine& engine, pos_t origin,
 	                                    pos_t target) const
 	{
-		const Map& map = engine.GetMap();
-
-		// Use libtcod's Bresenham line iterator
-		tcod::BresenhamLine line({ origin.x, origin.y },
-		                         { target.x, target.y });
-
-		// Check each tile along the line (excluding endpoints)
-		for (auto it = line.begin(); it != line.end(); ++it) {
-			auto [x, y] = *it;
-
-			// Skip the origin and target tiles
-			if ((x == origin.x && y == origin.y)
-			    || (x == target.x && y == target.y)) {
-				continue;
-			}
-
-			// If we hit a non-transparent tile, LOS is blocked
-			if (!map.IsTransparent(pos_t { x, y })) {
-				return false;
-			}
-		}
-
-		return true;
+		return engine.GetLineOfSight().HasLineOfSight(engine.GetMap(),
+		                                              origin, target);
 	}
 
 	// SelfTargetSelector - targets the user
@@ -153,16 +130,17 @@ namespace tutorial
 		}
 
 		// Find all entities in radius with line-of-sight
+		std::vector<Entity*> inRadius;
+		engine.GetEntities().QueryRadius(pos, effectRadius_, inRadius);
+
 		bool foundAny = false;
-		for (const auto& entity : engine.GetEntities()) {
+		for (auto* entity : inRadius) {
 			if (entity->GetDestructible()
 			    && !entity->GetDestructible()->IsDead()
 			    && !entity->IsCorpse() && !entity->GetItem()
-			    && entity->GetDistance(pos.x, pos.y)
-			           <= effectRadius_
 			    && HasLineOfSight(engine, user.GetPos(),
 			                      entity->GetPos())) {
-				targets.push_back(entity.get());
+				targets.push_back(entity);
 				foundAny = true;
 			}
 		}
@@ -200,23 +178,19 @@ namespace tutorial
 			return false;
 		}
 
-		// Trace beam from user to selected tile using Bresenham
+		// Trace beam from user to selected tile along its ray
 		const Map& map = engine.GetMap();
 		pos_t userPos = user.GetPos();
-		tcod::BresenhamLine line({ userPos.x, userPos.y },
-		                         { pos.x, pos.y });
+		auto [first, last] = engine.GetLineOfSight().GetRay(
+		    pos_t { pos.x - userPos.x, pos.y - userPos.y });
 
 		// Collect all tiles the beam passes through
 		std::vector<pos_t> beamTiles;
-		for (auto it = line.begin(); it != line.end(); ++it) {
-			auto [bx, by] = *it;
+		for (auto* step = first; step != last; ++step) {
+			int bx = userPos.x + step->x;
+			int by = userPos.y + step->y;
 			pos_t tilePos { bx, by };
 
-			// Skip the user's tile
-			if (bx == userPos.x && by == userPos.y) {
-				continue;
-			}
-
 			// Stop beam at walls
 			if (!map.IsTransparent(tilePos)) {
 				break;
@@ -233,12 +207,13 @@ namespace tutorial
 		// Find all entities on the beam path
 		bool foundAny = false;
 		for (const pos_t& tilePos : beamTiles) {
-			for (const auto& entity : engine.GetEntities()) {
+			for (auto* entity :
+			     engine.GetEntities().GetEntitiesAt(tilePos)) {
 				if (entity->GetDestructible()
 				    && !entity->GetDestructible()->IsDead()
-				    && !entity->IsCorpse() && !entity->GetItem()
-				    && entity->GetPos() == tilePos) {
-					targets.push_back(entity.get());
+				    && !entity->IsCorpse()
+				    && !entity->GetItem()) {
+					targets.push_back(entity);
 					foundAny = true;
 				}
 			}
@@ -278,22 +253,18 @@ namespace tutorial
 			return false;
 		}
 
-		// Trace beam from user to selected tile using Bresenham
+		// Trace beam from user to selected tile along its ray
 		const Map& map = engine.GetMap();
 		pos_t userPos = user.GetPos();
-		tcod::BresenhamLine line({ userPos.x, userPos.y },
-		                         { pos.x, pos.y });
+		auto [first, last] = engine.GetLineOfSight().GetRay(
+		    pos_t { pos.x - userPos.x, pos.y - userPos.y });
 
 		// Find FIRST valid target along the beam path
-		for (auto it = line.begin(); it != line.end(); ++it) {
-			auto [bx, by] = *it;
+		for (auto* step = first; step != last; ++step) {
+			int bx = userPos.x + step->x;
+			int by = userPos.y + step->y;
 			pos_t tilePos { bx, by };
 
-			// Skip the user's tile
-			if (bx == userPos.x && by == userPos.y) {
-				continue;
-			}
-
 			// Stop beam at walls
 			if (!map.IsTransparent(tilePos)) {
 				break;
@@ -305,13 +276,14 @@ namespace tutorial
 			}
 
 			// Check for entity at this position
-			for (const auto& entity : engine.GetEntities()) {
+			for (auto* entity :
+			     engine.GetEntities().GetEntitiesAt(tilePos)) {
 				if (entity->GetDestructible()
 				    && !entity->GetDestructible()->IsDead()
-				    && !entity->IsCorpse() && !entity->GetItem()
-				    && entity->GetPos() == tilePos) {
+				    && !entity->IsCorpse()
+				    && !entity->GetItem()) {
 					// Found first target - add it and stop
-					targets.push_back(entity.get());
+					targets.push_back(entity);
 					return true;
 				}
 			}
@@ -1,6 +1,7 @@
 #include "TemplateRegistry.hpp"
 
 #include "Entity.hpp"
+#include "TurnScheduler.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -162,6 +163,8 @@ namespace tutorial
 					entityTpl.defense = 0;
 					entityTpl.power = 0;
 					entityTpl.xpReward = 0;
+					entityTpl.speed =
+					    TurnScheduler::kNormalSpeed;
 					entityTpl.pickable = true;
 
 					// Convert item data to ItemData format
@@ -229,6 +232,7 @@ namespace tutorial
 					entityTpl.defense = unitTpl.defense;
 					entityTpl.power = unitTpl.power;
 					entityTpl.xpReward = unitTpl.xp;
+					entityTpl.speed = unitTpl.speed;
 					entityTpl.aiType = unitTpl.ai;
 					entityTpl.pickable = false;
 				}
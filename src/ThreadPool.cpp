@@ -0,0 +1,108 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace tutorial
+{
+	ThreadPool& ThreadPool::Instance()
+	{
+		static ThreadPool instance(
+		    std::max(1u, std::thread::hardware_concurrency()) - 1);
+		return instance;
+	}
+
+	ThreadPool::ThreadPool(unsigned int workerCount)
+	{
+		workers_.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i) {
+			workers_.emplace_back([this] { WorkerLoop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	void ThreadPool::ParallelFor(int count,
+	                             const std::function<void(int)>& fn)
+	{
+		if (count <= 0) {
+			return;
+		}
+
+		// Not worth waking anyone for a single iteration
+		if (workers_.empty() || count == 1) {
+			for (int i = 0; i < count; ++i) {
+				fn(i);
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> submit(submitMutex_);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job_ = &fn;
+			count_ = count;
+			next_.store(0, std::memory_order_relaxed);
+			busyWorkers_ = static_cast<int>(workers_.size());
+			++jobId_;
+		}
+		wake_.notify_all();
+
+		RunIterations();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		done_.wait(lock, [this] { return busyWorkers_ == 0; });
+		job_ = nullptr;
+	}
+
+	void ThreadPool::RunIterations()
+	{
+		while (true) {
+			int i = next_.fetch_add(1, std::memory_order_relaxed);
+			if (i >= count_) {
+				return;
+			}
+			(*job_)(i);
+		}
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		std::uint64_t seenJob = 0;
+
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				wake_.wait(lock, [&] {
+					return stopping_ || jobId_ != seenJob;
+				});
+
+				if (stopping_) {
+					return;
+				}
+
+				seenJob = jobId_;
+			}
+
+			RunIterations();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (--busyWorkers_ == 0) {
+					done_.notify_one();
+				}
+			}
+		}
+	}
+} // namespace tutorial
@@ -1,10 +1,9 @@
 #include "TrailGenerator.hpp"
 
 #include "Map.hpp"
+#include "Random.hpp"
 #include "Tile.hpp"
 
-#include <libtcod.h>
-
 #include <algorithm>
 
 namespace tutorial
@@ -22,8 +21,8 @@ namespace tutorial
 		// Choose random corridor length
 		int ChooseCorridorLength(const TrailConfig& config)
 		{
-			auto* rand = TCODRandom::getInstance();
-			return rand->getInt(config.minLength, config.maxLength);
+			auto& rand = GetRandom(RandomStream::Generation);
+			return rand.GetInt(config.minLength, config.maxLength);
 		}
 
 		// Calculate directional bias away from map edges
@@ -57,7 +56,7 @@ namespace tutorial
 	                                 const TrailConfig& config)
 	{
 		std::vector<pos_t> carved;
-		auto* rand = TCODRandom::getInstance();
+		auto& rand = GetRandom(RandomStream::Generation);
 
 		pos_t current = start;
 		carved.push_back(current);
@@ -101,7 +100,7 @@ namespace tutorial
 				float totalWeight =
 				    horizontalWeight + verticalWeight;
 
-				float roll = rand->getFloat(0.0f, totalWeight);
+				float roll = rand.GetFloat(0.0f, totalWeight);
 				moveHorizontal = (roll < horizontalWeight);
 			}
 
@@ -156,7 +155,7 @@ namespace tutorial
 				// Early exit from corridor if we intersect and
 				// roll succeeds
 				if (hitFloor
-				    && rand->getFloat(0.0f, 1.0f)
+				    && rand.GetFloat(0.0f, 1.0f)
 				           < config.intersectChance) {
 					break;
 				}
@@ -5,6 +5,8 @@
 #include "Entity.hpp"
 #include "Event.hpp"
 #include "SaveManager.hpp"
+#include "ThreadPool.hpp"
+#include "TurnScheduler.hpp"
 
 namespace tutorial
 {
@@ -29,21 +31,69 @@ namespace tutorial
 
 	void TurnManager::ProcessEnemyTurn(Engine& engine)
 	{
-		// Queue up enemy actions
-		const auto& entities = engine.GetEntities();
+		// One flood fill serves every chaser this turn; skipped when
+		// neither the player nor the terrain has changed
+		engine.UpdatePlayerFlowField();
 
-		for (auto& entity : entities) {
-			if (engine.IsPlayer(*entity.get())) {
+		// Batch every nearby monster's view of the player up front,
+		// then wake whoever it shows noticing them. Dormant actors
+		// further off are never looked at.
+		engine.UpdateMonsterVisibility();
+		engine.WakeNearbyActors();
+
+		// Every actor whose time has come, in timeline order
+		auto& entities = engine.entities_;
+		auto& scheduler = entities.GetScheduler();
+		scheduler.Advance(TurnScheduler::kActionCost);
+
+		++turn_;
+		due_.clear();
+		for (EntityHandle handle = scheduler.NextDue();
+		     !handle.IsNull(); handle = scheduler.NextDue()) {
+			Entity* entity = entities.Get(handle);
+			if (!entity || !entity->CanAct()) {
+				scheduler.Remove(handle);
 				continue;
 			}
 
-			if (!entity->CanAct()) {
-				continue;
+			// A fast actor's later turns depend on where its first
+			// one left it, so only its first is planned ahead
+			if (handle.index >= plannedAt_.size()) {
+				plannedAt_.resize(handle.index + 1, 0);
 			}
+			bool planAhead = plannedAt_[handle.index] != turn_;
+			plannedAt_[handle.index] = turn_;
+
+			due_.push_back({ handle, planAhead });
+		}
+
+		// Decide: each plan reads only the world as it stood when the
+		// turn began, and nothing writes to it until every plan is
+		// in, so they can be made on all cores and still come out
+		// the same on every run
+		intents_.assign(due_.size(), AiIntent {});
+		const auto& ai = entities.GetComponents().ai;
+
+		ThreadPool::Instance().ParallelFor(
+		    static_cast<int>(due_.size()), [&](int i) {
+			    if (!due_[i].planAhead) {
+				    return;
+			    }
+
+			    EntityHandle handle = due_[i].handle;
+			    const auto* slot = ai.Get(handle.index);
+			    if (slot && *slot) {
+				    intents_[i] = (*slot)->Decide(
+				        engine, *entities.Get(handle));
+			    }
+		    });
 
-			std::unique_ptr<Event> event =
-			    std::make_unique<AiAction>(engine, *entity);
-			engine.AddEventFront(event);
+		// Commit: one actor at a time in timeline order. Each
+		// AiAction runs its plan against the moves committed before
+		// it, settling any clash such as two actors wanting one tile.
+		for (std::size_t i = 0; i < due_.size(); ++i) {
+			Entity* entity = entities.Get(due_[i].handle);
+			engine.AddEvent(AiAction(engine, *entity, intents_[i]));
 		}
 
 		// Process all enemy actions
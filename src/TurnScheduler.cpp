@@ -0,0 +1,161 @@
+#include "TurnScheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace tutorial
+{
+	void TurnScheduler::Clear()
+	{
+		heap_.clear();
+		positions_.clear();
+		now_ = 0;
+		nextSequence_ = 0;
+	}
+
+	void TurnScheduler::Add(EntityHandle actor, int speed)
+	{
+		if (actor.IsNull()) {
+			return;
+		}
+
+		// A slot holds one actor, so whatever sits in this one goes,
+		// even if it is an older generation
+		if (actor.index >= positions_.size()) {
+			positions_.resize(actor.index + 1, kAbsent);
+		} else if (positions_[actor.index] != kAbsent) {
+			Erase(positions_[actor.index]);
+		}
+
+		int delay = std::max(
+		    kActionCost * kNormalSpeed / std::max(speed, 1), 1);
+		Entry entry { now_ + static_cast<std::uint64_t>(delay),
+			      nextSequence_++, actor, delay };
+
+		heap_.push_back(entry);
+		positions_[actor.index] =
+		    static_cast<std::uint32_t>(heap_.size() - 1);
+		SiftUp(heap_.size() - 1);
+	}
+
+	void TurnScheduler::Remove(EntityHandle actor)
+	{
+		std::uint32_t index = Find(actor);
+		if (index != kAbsent) {
+			Erase(index);
+		}
+	}
+
+	bool TurnScheduler::Contains(EntityHandle actor) const
+	{
+		return Find(actor) != kAbsent;
+	}
+
+	void TurnScheduler::Advance(int ticks)
+	{
+		now_ += static_cast<std::uint64_t>(std::max(ticks, 0));
+	}
+
+	EntityHandle TurnScheduler::NextDue()
+	{
+		if (heap_.empty() || heap_.front().time > now_) {
+			return EntityHandle {};
+		}
+
+		// Push the actor one action along and let it sink to its
+		// new place; it stays in the heap, so nothing is allocated
+		Entry& top = heap_.front();
+		EntityHandle actor = top.actor;
+		top.time += static_cast<std::uint64_t>(top.delay);
+		top.sequence = nextSequence_++;
+		SiftDown(0);
+
+		return actor;
+	}
+
+	bool TurnScheduler::Less(std::size_t a, std::size_t b) const
+	{
+		const Entry& lhs = heap_[a];
+		const Entry& rhs = heap_[b];
+		return (lhs.time != rhs.time) ? lhs.time < rhs.time
+		                              : lhs.sequence < rhs.sequence;
+	}
+
+	void TurnScheduler::Place(std::size_t index, Entry entry)
+	{
+		heap_[index] = entry;
+		positions_[entry.actor.index] =
+		    static_cast<std::uint32_t>(index);
+	}
+
+	void TurnScheduler::SiftUp(std::size_t index)
+	{
+		while (index > 0) {
+			std::size_t parent = (index - 1) / 2;
+			if (!Less(index, parent)) {
+				break;
+			}
+
+			Entry moved = heap_[parent];
+			Place(parent, heap_[index]);
+			Place(index, moved);
+			index = parent;
+		}
+	}
+
+	void TurnScheduler::SiftDown(std::size_t index)
+	{
+		for (;;) {
+			std::size_t smallest = index;
+			std::size_t left = index * 2 + 1;
+			std::size_t right = left + 1;
+
+			if (left < heap_.size() && Less(left, smallest)) {
+				smallest = left;
+			}
+			if (right < heap_.size() && Less(right, smallest)) {
+				smallest = right;
+			}
+			if (smallest == index) {
+				break;
+			}
+
+			Entry moved = heap_[smallest];
+			Place(smallest, heap_[index]);
+			Place(index, moved);
+			index = smallest;
+		}
+	}
+
+	void TurnScheduler::Erase(std::size_t index)
+	{
+		positions_[heap_[index].actor.index] = kAbsent;
+
+		// Fill the hole with the last entry, which may belong above
+		// or below it
+		std::size_t last = heap_.size() - 1;
+		if (index != last) {
+			Place(index, heap_[last]);
+		}
+		heap_.pop_back();
+
+		if (index < heap_.size()) {
+			SiftUp(index);
+			SiftDown(index);
+		}
+	}
+
+	std::uint32_t TurnScheduler::Find(EntityHandle actor) const
+	{
+		if (actor.IsNull() || actor.index >= positions_.size()) {
+			return kAbsent;
+		}
+
+		std::uint32_t index = positions_[actor.index];
+		if (index == kAbsent || heap_[index].actor != actor) {
+			return kAbsent;
+		}
+
+		return index;
+	}
+} // namespace tutorial
@@ -0,0 +1,120 @@
+#include "VisibilityService.hpp"
+
+#include "Fov.hpp"
+#include "Map.hpp"
+#include "ThreadPool.hpp"
+#include "Util.hpp"
+
+#include <algorithm>
+
+namespace tutorial
+{
+	void VisibilityService::Update(const Map& map,
+	                               const std::vector<Viewer>& viewers,
+	                               int radius)
+	{
+		if (radius <= 0) {
+			radius = std::max(map.GetWidth(), map.GetHeight());
+		}
+
+		// Any terrain change can alter any view
+		if (map_ != &map || terrainVersion_ != map.GetTerrainVersion()
+		    || radius_ != radius) {
+			cache_.clear();
+			map_ = &map;
+			terrainVersion_ = map.GetTerrainVersion();
+			radius_ = radius;
+		}
+
+		++updateCount_;
+		for (auto& slot : viewers_) {
+			slot.view = nullptr;
+		}
+
+		int side = 2 * radius + 1;
+		pending_.clear();
+		lastCacheHits_ = 0;
+
+		for (const auto& viewer : viewers) {
+			if (!map.IsInBounds(viewer.origin)) {
+				continue;
+			}
+
+			auto& view = cache_[util::posToIndex(viewer.origin,
+			                                     map.GetWidth())];
+			if (!view) {
+				view = std::make_unique<View>();
+				view->windowOrigin =
+				    viewer.origin - pos_t { radius, radius };
+				view->bits.Assign(side * side, false);
+				pending_.emplace_back(viewer.origin, view.get());
+			} else if (view->lastUsed != updateCount_) {
+				++lastCacheHits_;
+			}
+			view->lastUsed = updateCount_;
+
+			if (viewer.handle.index >= viewers_.size()) {
+				viewers_.resize(viewer.handle.index + 1);
+			}
+			viewers_[viewer.handle.index] =
+			    ViewerSlot { viewer.handle.generation, view.get() };
+		}
+
+		// Views are independent and the planes are read-only here
+		const auto& transparent = map.GetTransparentPlane();
+		int width = map.GetWidth();
+		int height = map.GetHeight();
+
+		ThreadPool::Instance().ParallelFor(
+		    static_cast<int>(pending_.size()), [&](int i) {
+			    View* view = pending_[i].second;
+			    ComputeShadowcastFov(transparent, width, height,
+			                         pending_[i].first, radius,
+			                         view->bits, view->windowOrigin,
+			                         pos_t { side, side });
+		    });
+
+		lastComputed_ = static_cast<int>(pending_.size());
+
+		// Drop views nobody stood in this turn once the cache grows
+		if (cache_.size() > kMaxCachedViews) {
+			for (auto it = cache_.begin(); it != cache_.end();) {
+				if (it->second->lastUsed != updateCount_) {
+					it = cache_.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+	}
+
+	bool VisibilityService::CanSee(EntityHandle viewer, pos_t tile) const
+	{
+		if (viewer.index >= viewers_.size()) {
+			return false;
+		}
+
+		const auto& slot = viewers_[viewer.index];
+		if (!slot.view || slot.generation != viewer.generation) {
+			return false;
+		}
+
+		int side = 2 * radius_ + 1;
+		pos_t local { tile.x - slot.view->windowOrigin.x,
+			      tile.y - slot.view->windowOrigin.y };
+		if (local.x < 0 || local.y < 0 || local.x >= side
+		    || local.y >= side) {
+			return false;
+		}
+
+		return slot.view->bits.Get(util::posToIndex(local, side));
+	}
+
+	void VisibilityService::Clear()
+	{
+		cache_.clear();
+		viewers_.clear();
+		pending_.clear();
+		map_ = nullptr;
+	}
+} // namespace tutorial